@@ -0,0 +1,295 @@
+#include "arrow_export.h"
+
+#include "column_batch.h"
+
+#include <limits>
+
+namespace TbApiImpl {
+namespace Python {
+
+static const char *ARROW_SCHEMA_CAPSULE_NAME = "arrow_schema";
+static const char *ARROW_ARRAY_CAPSULE_NAME = "arrow_array";
+
+// owns strings and children of exported schema
+struct ArrowSchemaData {
+    std::string format;
+    std::string name;
+    std::vector<ArrowSchema *> children;
+};
+
+// owns buffers and children of exported array
+struct ArrowArrayData {
+    std::vector<const void *> buffers;
+    std::vector<ArrowArray *> children;
+
+    std::vector<uint8_t> validity;
+    std::vector<int64_t> int64_values;
+    std::vector<double> float64_values;
+    std::vector<uint8_t> bytes;
+    std::vector<int32_t> offsets;
+};
+
+static void releaseSchema(ArrowSchema *schema) {
+    if (schema->release == NULL)
+        return;
+
+    ArrowSchemaData *data = (ArrowSchemaData *) schema->private_data;
+    for (ArrowSchema *child : data->children) {
+        if (child->release != NULL)
+            child->release(child);
+        delete child;
+    }
+
+    if (schema->dictionary != NULL) {
+        if (schema->dictionary->release != NULL)
+            schema->dictionary->release(schema->dictionary);
+        delete schema->dictionary;
+    }
+
+    delete data;
+    schema->release = NULL;
+}
+
+static void releaseArray(ArrowArray *array) {
+    if (array->release == NULL)
+        return;
+
+    ArrowArrayData *data = (ArrowArrayData *) array->private_data;
+    for (ArrowArray *child : data->children) {
+        if (child->release != NULL)
+            child->release(child);
+        delete child;
+    }
+
+    if (array->dictionary != NULL) {
+        if (array->dictionary->release != NULL)
+            array->dictionary->release(array->dictionary);
+        delete array->dictionary;
+    }
+
+    delete data;
+    array->release = NULL;
+}
+
+static ArrowSchema * newSchema(const std::string &format, const std::string &name, int64_t flags) {
+    ArrowSchemaData *data = new ArrowSchemaData();
+    data->format = format;
+    data->name = name;
+
+    ArrowSchema *schema = new ArrowSchema();
+    schema->format = data->format.c_str();
+    schema->name = data->name.c_str();
+    schema->metadata = NULL;
+    schema->flags = flags;
+    schema->n_children = 0;
+    schema->children = NULL;
+    schema->dictionary = NULL;
+    schema->release = releaseSchema;
+    schema->private_data = data;
+    return schema;
+}
+
+static ArrowArray * newArray(int64_t length, int64_t null_count, ArrowArrayData *data) {
+    ArrowArray *array = new ArrowArray();
+    array->length = length;
+    array->null_count = null_count;
+    array->offset = 0;
+    array->n_buffers = (int64_t) data->buffers.size();
+    array->buffers = data->buffers.data();
+    array->n_children = (int64_t) data->children.size();
+    array->children = data->children.empty() ? NULL : data->children.data();
+    array->dictionary = NULL;
+    array->release = releaseArray;
+    array->private_data = data;
+    return array;
+}
+
+static void setBit(std::vector<uint8_t> &bitmap, size_t index) {
+    bitmap[index / 8] |= (uint8_t) (1 << (index % 8));
+}
+
+// fills validity bitmap, returns number of nulls
+static int64_t buildValidity(const std::vector<uint8_t> &nulls, std::vector<uint8_t> &validity) {
+    int64_t null_count = 0;
+    for (uint8_t is_null : nulls)
+        null_count += is_null;
+
+    if (null_count == 0)
+        return 0;
+
+    validity.assign((nulls.size() + 7) / 8, 0);
+    for (size_t i = 0; i < nulls.size(); ++i) {
+        if (!nulls[i])
+            setBit(validity, i);
+    }
+
+    return null_count;
+}
+
+static void buildStrings(const std::vector<std::string> &values, const std::vector<uint8_t> *nulls, ArrowArrayData *data) {
+    size_t total_size = 0;
+    for (const std::string &value : values)
+        total_size += value.size();
+    if (total_size > (size_t) std::numeric_limits<int32_t>::max())
+        THROW("String column is too large for arrow utf8 array.");
+
+    data->offsets.reserve(values.size() + 1);
+    data->bytes.reserve(total_size);
+    data->offsets.push_back(0);
+    for (size_t i = 0; i < values.size(); ++i) {
+        if (nulls == NULL || !(*nulls)[i])
+            data->bytes.insert(data->bytes.end(), values[i].begin(), values[i].end());
+        data->offsets.push_back((int32_t) data->bytes.size());
+    }
+}
+
+static ArrowArray * exportCategories(const Column &column) {
+    const std::vector<std::string> &categories = column.getCategories();
+
+    ArrowArrayData *data = new ArrowArrayData();
+    buildStrings(categories, NULL, data);
+    data->buffers = { NULL, data->offsets.data(), data->bytes.data() };
+    return newArray((int64_t) categories.size(), 0, data);
+}
+
+static void addChild(ArrowSchema *schema, ArrowArray *array, ArrowSchema *child_schema, ArrowArray *child_array) {
+    ArrowSchemaData *schema_data = (ArrowSchemaData *) schema->private_data;
+    schema_data->children.push_back(child_schema);
+    schema->n_children = (int64_t) schema_data->children.size();
+    schema->children = schema_data->children.data();
+
+    ArrowArrayData *array_data = (ArrowArrayData *) array->private_data;
+    array_data->children.push_back(child_array);
+    array->n_children = (int64_t) array_data->children.size();
+    array->children = array_data->children.data();
+}
+
+// returns false, if column can't be exported
+static bool exportColumn(Column &column, size_t size, ArrowSchema **schema, ArrowArray **array) {
+    if (column.getType() == OBJECT_COLUMN || (column.getType() == LIST_COLUMN && column.getElements() == NULL))
+        return false;
+
+    ArrowSchema *elements_schema = NULL;
+    ArrowArray *elements_array = NULL;
+    if (column.getType() == LIST_COLUMN) {
+        Column &elements = *column.getElements();
+        if (!exportColumn(elements, elements.size(), &elements_schema, &elements_array))
+            return false;
+    }
+
+    ArrowArrayData *data = new ArrowArrayData();
+    int64_t null_count = buildValidity(column.getNulls(), data->validity);
+    const void *validity = null_count > 0 ? data->validity.data() : NULL;
+
+    std::string format;
+    switch (column.getType()) {
+    case INT64_COLUMN:
+        format = column.getArrowFormat() != NULL ? column.getArrowFormat() : "l";
+        data->int64_values.swap(column.getInt64Values());
+        data->buffers = { validity, data->int64_values.data() };
+        break;
+    case FLOAT64_COLUMN:
+        format = "g";
+        data->float64_values.swap(column.getFloat64Values());
+        data->buffers = { validity, data->float64_values.data() };
+        break;
+    case BOOLEAN_COLUMN: {
+        format = "b";
+        const std::vector<uint8_t> &values = column.getBooleanValues();
+        data->bytes.assign((values.size() + 7) / 8, 0);
+        for (size_t i = 0; i < values.size(); ++i) {
+            if (values[i])
+                setBit(data->bytes, i);
+        }
+        data->buffers = { validity, data->bytes.data() };
+        break;
+    }
+    case STRING_COLUMN:
+        format = "u";
+        buildStrings(column.getStringValues(), &column.getNulls(), data);
+        data->buffers = { validity, data->offsets.data(), data->bytes.data() };
+        break;
+    case CATEGORY_COLUMN:
+        // dictionary encoded: int64 codes are indices of categories
+        format = "l";
+        data->int64_values.swap(column.getInt64Values());
+        data->buffers = { validity, data->int64_values.data() };
+        break;
+    case LIST_COLUMN:
+        format = "+l";
+        data->offsets.swap(column.getOffsets());
+        data->buffers = { validity, data->offsets.data() };
+        break;
+    case OBJECT_COLUMN:
+        break;
+    }
+
+    *schema = newSchema(format, column.getName(), ARROW_FLAG_NULLABLE);
+    *array = newArray((int64_t) size, null_count, data);
+
+    if (column.getType() == LIST_COLUMN)
+        addChild(*schema, *array, elements_schema, elements_array);
+
+    if (column.getType() == CATEGORY_COLUMN) {
+        (*schema)->dictionary = newSchema("u", "", ARROW_FLAG_NULLABLE);
+        (*array)->dictionary = exportCategories(column);
+    }
+
+    return true;
+}
+
+static void deleteSchemaCapsule(PyObject *capsule) {
+    ArrowSchema *schema = (ArrowSchema *) PyCapsule_GetPointer(capsule, ARROW_SCHEMA_CAPSULE_NAME);
+    if (schema == NULL)
+        return;
+
+    if (schema->release != NULL)
+        schema->release(schema);
+    delete schema;
+}
+
+static void deleteArrayCapsule(PyObject *capsule) {
+    ArrowArray *array = (ArrowArray *) PyCapsule_GetPointer(capsule, ARROW_ARRAY_CAPSULE_NAME);
+    if (array == NULL)
+        return;
+
+    // consumer moves array and sets release to NULL
+    if (array->release != NULL)
+        array->release(array);
+    delete array;
+}
+
+PyObject * exportArrowBatch(ColumnBatch &batch) {
+    ArrowSchema *schema = newSchema("+s", "", 0);
+    ArrowArrayData *data = new ArrowArrayData();
+    data->buffers = { NULL };
+
+    ArrowArray *array = newArray((int64_t) batch.size(), 0, data);
+    for (size_t i = 0; i < batch.getColumnsCount(); ++i) {
+        ArrowSchema *child_schema;
+        ArrowArray *child_array;
+        if (exportColumn(*batch.columnAt(i), batch.size(), &child_schema, &child_array))
+            addChild(schema, array, child_schema, child_array);
+    }
+
+    PythonRefHolder schema_capsule(PyCapsule_New(schema, ARROW_SCHEMA_CAPSULE_NAME, deleteSchemaCapsule));
+    if (schema_capsule.getReference() == NULL) {
+        releaseSchema(schema);
+        delete schema;
+        releaseArray(array);
+        delete array;
+        THROW("Can't create capsule of arrow schema.");
+    }
+
+    PythonRefHolder array_capsule(PyCapsule_New(array, ARROW_ARRAY_CAPSULE_NAME, deleteArrayCapsule));
+    if (array_capsule.getReference() == NULL) {
+        releaseArray(array);
+        delete array;
+        THROW("Can't create capsule of arrow array.");
+    }
+
+    return PyTuple_Pack(2, schema_capsule.getReference(), array_capsule.getReference());
+}
+
+}
+}
@@ -0,0 +1,60 @@
+#ifndef DELTIX_API_CODECS_ARROW_EXPORT_H_
+#define DELTIX_API_CODECS_ARROW_EXPORT_H_
+
+#include "Python.h"
+
+#include <cstdint>
+
+// Apache Arrow C Data Interface, https://arrow.apache.org/docs/format/CDataInterface.html
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+struct ArrowSchema {
+    const char* format;
+    const char* name;
+    const char* metadata;
+    int64_t flags;
+    int64_t n_children;
+    struct ArrowSchema** children;
+    struct ArrowSchema* dictionary;
+
+    void (*release)(struct ArrowSchema*);
+    void* private_data;
+};
+
+struct ArrowArray {
+    int64_t length;
+    int64_t null_count;
+    int64_t offset;
+    int64_t n_buffers;
+    int64_t n_children;
+    const void** buffers;
+    struct ArrowArray** children;
+    struct ArrowArray* dictionary;
+
+    void (*release)(struct ArrowArray*);
+    void* private_data;
+};
+
+#endif  // ARROW_C_DATA_INTERFACE
+
+namespace TbApiImpl {
+namespace Python {
+
+class ColumnBatch;
+
+// Exports batch as arrow struct array (record batch) and returns tuple of PyCapsules
+// ("arrow_schema", "arrow_array") of the Arrow PyCapsule Interface.
+// Int64 and float64 buffers are moved from the batch without copying, batch must be cleared after export.
+// List columns (arrays) are exported as arrow lists, object columns (objects, arrays of objects,
+// binary and char fields) are not exported.
+PyObject * exportArrowBatch(ColumnBatch &batch);
+
+}
+}
+
+#endif //DELTIX_API_CODECS_ARROW_EXPORT_H_
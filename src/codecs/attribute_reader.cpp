@@ -0,0 +1,155 @@
+#include "attribute_reader.h"
+
+#include "structmember.h"
+
+namespace TbApiImpl {
+namespace Python {
+
+// max number of python types with plans, plans are cleared when it's exceeded
+static const size_t MAX_ATTRIBUTE_PLANS = 64;
+
+AttributePlan::~AttributePlan() {
+    for (PyObject *value : defaults)
+        Py_XDECREF(value);
+    Py_XDECREF((PyObject *) type);
+}
+
+static inline bool hasValidVersion(PyTypeObject *type) {
+    return PyType_HasFeature(type, Py_TPFLAGS_VALID_VERSION_TAG);
+}
+
+// returns borrowed reference to attribute of type or its bases, like lookup of PyObject_GenericGetAttr
+static PyObject * lookupTypeAttribute(PyTypeObject *type, PyObject *key) {
+    PyObject *mro = type->tp_mro;
+    if (mro == NULL)
+        return NULL;
+
+    for (Py_ssize_t i = 0; i < PyTuple_GET_SIZE(mro); ++i) {
+        PyObject *dict = ((PyTypeObject *) PyTuple_GET_ITEM(mro, i))->tp_dict;
+        PyObject *value = dict != NULL ? PyDict_GetItem(dict, key) : NULL;
+        if (value != NULL)
+            return value;
+    }
+
+    return NULL;
+}
+
+AttributeReader::AttributeReader(const std::vector<PyObject *> &keys) : keys_(keys) {
+    for (PyObject *key : keys_)
+        Py_INCREF(key);
+}
+
+AttributeReader::~AttributeReader() {
+    plans_.clear();
+    for (PyObject *key : keys_)
+        Py_DECREF(key);
+}
+
+const AttributePlan & AttributeReader::getPlan(PyTypeObject *type) {
+    if (last_plan_ != NULL && last_plan_->type == type && hasValidVersion(type) && last_plan_->version == type->tp_version_tag)
+        return *last_plan_;
+
+    std::unique_ptr<AttributePlan> &plan = plans_[type];
+    if (plan == nullptr || !hasValidVersion(type) || plan->version != type->tp_version_tag) {
+        if (plan == nullptr && plans_.size() > MAX_ATTRIBUTE_PLANS) {
+            last_plan_ = NULL;
+            plans_.clear();
+            return getPlan(type);
+        }
+
+        plan.reset(new AttributePlan());
+        buildPlan(type, *plan);
+    }
+
+    last_plan_ = plan.get();
+    return *plan;
+}
+
+void AttributeReader::buildPlan(PyTypeObject *type, AttributePlan &plan) {
+    // plan keeps type alive, so its address is not reused by other type
+    Py_INCREF((PyObject *) type);
+    plan.type = type;
+
+    bool generic_type = type->tp_getattro != PyObject_GenericGetAttr;
+    for (PyObject *key : keys_) {
+        AttributeKind kind = GENERIC_ATTRIBUTE;
+        Py_ssize_t offset = 0;
+        PyObject *default_value = NULL;
+
+        PyObject *attribute = generic_type ? NULL : lookupTypeAttribute(type, key);
+        if (generic_type) {
+            kind = GENERIC_ATTRIBUTE;
+        } else if (attribute == NULL) {
+            kind = DICT_ATTRIBUTE;
+        } else if (Py_TYPE(attribute) == &PyMemberDescr_Type &&
+            ((PyMemberDescrObject *) attribute)->d_member->type == T_OBJECT_EX) {
+            kind = SLOT_ATTRIBUTE;
+            offset = ((PyMemberDescrObject *) attribute)->d_member->offset;
+        } else if (Py_TYPE(attribute)->tp_descr_get == NULL) {
+            // plain class attribute is a default of instance attribute
+            kind = DICT_ATTRIBUTE;
+            default_value = attribute;
+            Py_INCREF(default_value);
+        }
+
+        plan.uses_dict |= kind == DICT_ATTRIBUTE;
+        plan.kinds.push_back(kind);
+        plan.offsets.push_back(offset);
+        plan.defaults.push_back(default_value);
+    }
+
+    // objects without __dict__ have only class attributes
+    if (type->tp_dictoffset == 0)
+        plan.uses_dict = false;
+
+    // version tag is assigned by lookups in type cache: lookup of any attribute of type assigns it
+    if (!hasValidVersion(type) && !keys_.empty()) {
+        PyObject *value = PyObject_GetAttr((PyObject *) type, keys_[0]);
+        if (value == NULL)
+            PyErr_Clear();
+        Py_XDECREF(value);
+    }
+
+    // without version tag (version tags are exhausted) plan is rebuilt for every object
+    plan.version = hasValidVersion(type) ? type->tp_version_tag : 0;
+}
+
+AttributeAccessor::AttributeAccessor(AttributeReader &reader, PyObject *object)
+    : reader_(reader), plan_(reader.getPlan(Py_TYPE(object))), object_(object)
+{
+    if (plan_.uses_dict) {
+        dict_ = PyObject_GenericGetDict(object, NULL);
+        if (dict_ == NULL)
+            PyErr_Clear();
+    }
+}
+
+AttributeAccessor::~AttributeAccessor() {
+    Py_XDECREF(dict_);
+}
+
+PyObject * AttributeAccessor::get(size_t index) {
+    PyObject *value = NULL;
+    switch (plan_.kinds[index]) {
+    case SLOT_ATTRIBUTE:
+        value = *(PyObject **) ((char *) object_ + plan_.offsets[index]);
+        break;
+    case DICT_ATTRIBUTE:
+        if (dict_ != NULL)
+            value = PyDict_GetItem(dict_, reader_.getKey(index));
+        if (value == NULL)
+            value = plan_.defaults[index];
+        break;
+    case GENERIC_ATTRIBUTE:
+        value = PyObject_GetAttr(object_, reader_.getKey(index));
+        if (value == NULL)
+            PyErr_Clear();
+        return value;
+    }
+
+    Py_XINCREF(value);
+    return value;
+}
+
+}
+}
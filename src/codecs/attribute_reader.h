@@ -0,0 +1,80 @@
+#ifndef DELTIX_API_CODECS_ATTRIBUTE_READER_H_
+#define DELTIX_API_CODECS_ATTRIBUTE_READER_H_
+
+#include "Python.h"
+
+#include "python_common.h"
+#include "dxapi.h"
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace TbApiImpl {
+namespace Python {
+
+// How attribute is read from objects of one python type.
+enum AttributeKind {
+    SLOT_ATTRIBUTE,     // __slots__ member, read at offset
+    DICT_ATTRIBUTE,     // read from instance __dict__, class attribute (e.g. dataclass default) is used, if it's absent
+    GENERIC_ATTRIBUTE   // properties, __getattr__ hooks and other descriptors, read with PyObject_GetAttr
+};
+
+struct AttributePlan {
+    PyTypeObject *type = NULL;
+    unsigned int version = 0;
+    bool uses_dict = false;
+    std::vector<AttributeKind> kinds;
+    std::vector<Py_ssize_t> offsets;
+    std::vector<PyObject *> defaults;
+
+    ~AttributePlan();
+};
+
+// Reads fixed set of attributes of objects (fields of messages).
+// Layout of every python type is resolved once into a plan: slots are read at their offsets,
+// other attributes with one lookup in instance __dict__ instead of PyObject_HasAttr and PyObject_GetAttr.
+// Plans are rebuilt, when type is modified (version tag of type changes).
+class AttributeReader {
+public:
+    AttributeReader(const std::vector<PyObject *> &keys);
+    ~AttributeReader();
+
+    const AttributePlan & getPlan(PyTypeObject *type);
+
+    PyObject * getKey(size_t index) const {
+        return keys_[index];
+    }
+
+private:
+    DISALLOW_COPY_AND_ASSIGN(AttributeReader);
+
+    void buildPlan(PyTypeObject *type, AttributePlan &plan);
+
+    std::vector<PyObject *> keys_;
+    std::unordered_map<PyTypeObject *, std::unique_ptr<AttributePlan>> plans_;
+    AttributePlan *last_plan_ = NULL;
+};
+
+// Attributes of one object, read with plan of its type.
+class AttributeAccessor {
+public:
+    AttributeAccessor(AttributeReader &reader, PyObject *object);
+    ~AttributeAccessor();
+
+    // returns new reference to value of attribute, NULL if object has no attribute
+    PyObject * get(size_t index);
+
+private:
+    DISALLOW_COPY_AND_ASSIGN(AttributeAccessor);
+
+    AttributeReader &reader_;
+    const AttributePlan &plan_;
+    PyObject *object_;
+    PyObject *dict_ = NULL;
+};
+
+}
+}
+
+#endif //DELTIX_API_CODECS_ATTRIBUTE_READER_H_
@@ -0,0 +1,86 @@
+#include "binary_buffer.h"
+
+namespace TbApiImpl {
+namespace Python {
+
+struct BinaryBufferObject {
+    PyObject_HEAD
+    std::vector<uint8_t> *data;
+};
+
+static void deallocBinaryBuffer(PyObject *self) {
+    BinaryBufferObject *buffer = (BinaryBufferObject *) self;
+    delete buffer->data;
+
+    PyTypeObject *type = Py_TYPE(self);
+    type->tp_free(self);
+    Py_DECREF(type);
+}
+
+static int getBinaryBuffer(PyObject *self, Py_buffer *view, int flags) {
+    static uint8_t empty = 0;
+
+    BinaryBufferObject *buffer = (BinaryBufferObject *) self;
+    void *data = buffer->data->empty() ? &empty : buffer->data->data();
+    return PyBuffer_FillInfo(view, self, data, (Py_ssize_t) buffer->data->size(), 1, flags);
+}
+
+#if PY_VERSION_HEX < 0x03090000
+// buffer slots of PyType_Spec are available since python 3.9 only
+static PyBufferProcs BINARY_BUFFER_PROCS = {
+    getBinaryBuffer,
+    NULL
+};
+#endif
+
+static PyType_Slot BINARY_BUFFER_SLOTS[] = {
+    { Py_tp_dealloc, (void *) deallocBinaryBuffer },
+#if PY_VERSION_HEX >= 0x03090000
+    { Py_bf_getbuffer, (void *) getBinaryBuffer },
+#endif
+#if PY_VERSION_HEX < 0x030A0000
+    { Py_tp_new, (void *) newNativeObject },
+#endif
+    { 0, NULL }
+};
+
+static PyType_Spec BINARY_BUFFER_SPEC = {
+    "tbapi.BinaryBuffer",
+    sizeof(BinaryBufferObject),
+    0,
+    NATIVE_TYPE_FLAGS,
+    BINARY_BUFFER_SLOTS
+};
+
+PyObject * newBinaryBuffer() {
+    // type is created once and never released
+    static PyObject *buffer_type = NULL;
+    if (buffer_type == NULL) {
+        buffer_type = PyType_FromSpec(&BINARY_BUFFER_SPEC);
+        if (buffer_type == NULL)
+            THROW("Can't create type of binary buffer.");
+
+#if PY_VERSION_HEX < 0x03090000
+        ((PyTypeObject *) buffer_type)->tp_as_buffer = &BINARY_BUFFER_PROCS;
+        PyType_Modified((PyTypeObject *) buffer_type);
+#endif
+    }
+
+    BinaryBufferObject *buffer = PyObject_New(BinaryBufferObject, (PyTypeObject *) buffer_type);
+    if (buffer == NULL)
+        THROW("Can't create binary buffer.");
+
+#if PY_VERSION_HEX < 0x03080000
+    // instances of heap types own reference to their type, newer versions take it in PyObject_New
+    Py_INCREF(buffer_type);
+#endif
+    buffer->data = new std::vector<uint8_t>();
+    return (PyObject *) buffer;
+}
+
+std::vector<uint8_t> & getBinaryBufferData(PyObject *buffer) {
+    return *((BinaryBufferObject *) buffer)->data;
+}
+
+}
+}
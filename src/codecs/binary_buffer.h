@@ -0,0 +1,23 @@
+#ifndef DELTIX_API_CODECS_BINARY_BUFFER_H_
+#define DELTIX_API_CODECS_BINARY_BUFFER_H_
+
+#include "Python.h"
+
+#include "python_common.h"
+
+#include <vector>
+
+namespace TbApiImpl {
+namespace Python {
+
+// Returns new read-only buffer object, which owns bytes of binary field value.
+// Codecs copy binary values from reader into new buffer and return read-only memoryviews of it,
+// buffer lives while memoryviews refer to it.
+PyObject * newBinaryBuffer();
+
+std::vector<uint8_t> & getBinaryBufferData(PyObject *buffer);
+
+}
+}
+
+#endif //DELTIX_API_CODECS_BINARY_BUFFER_H_
@@ -0,0 +1,103 @@
+#include "codec_cache.h"
+
+#include <functional>
+
+namespace TbApiImpl {
+namespace Python {
+
+// max number of distinct schemas kept in cache, cache is cleared when it's exceeded
+static const size_t MAX_CACHED_SCHEMAS = 256;
+
+// max number of idle codecs of one class
+static const size_t MAX_IDLE_CODECS = 16;
+
+CodecCache & CodecCache::instance() {
+    // intentionally leaked, cached codecs hold python objects and can't be released after finalization
+    static CodecCache *cache = new CodecCache();
+    return *cache;
+}
+
+CodecCache::CodecCache() {
+}
+
+CachedSchemaPtr CodecCache::getSchema(const std::string &text) {
+    size_t hash = std::hash<std::string>()(text);
+
+    {
+        MutexHolder mutex_holder(&lock_);
+        auto it = schemas_.find(hash);
+        if (it != schemas_.end()) {
+            for (const CachedSchemaPtr &schema : it->second) {
+                if (schema->text == text)
+                    return schema;
+            }
+        }
+    }
+
+    // parse outside of lock, concurrent parsing of the same schema is harmless
+    CachedSchemaPtr schema(new CachedSchema());
+    schema->text = text;
+    schema->descriptors = Schema::TickDbClassDescriptor::parseDescriptors(text, true);
+
+    MutexHolder mutex_holder(&lock_);
+    std::vector<CachedSchemaPtr> &bucket = schemas_[hash];
+    for (const CachedSchemaPtr &cached : bucket) {
+        if (cached->text == text)
+            return cached;
+    }
+
+    if (schemas_count_ >= MAX_CACHED_SCHEMAS) {
+        // schemas in use stay alive with their owners
+        schemas_.clear();
+        schemas_count_ = 0;
+    }
+
+    schemas_[hash].push_back(schema);
+    ++schemas_count_;
+    return schema;
+}
+
+MessageCodecPtr CodecCache::acquireCodec(const CachedSchemaPtr &schema, intptr_t descriptor_id) {
+    MessageCodec *codec = NULL;
+    {
+        MutexHolder mutex_holder(&lock_);
+        std::vector<std::unique_ptr<MessageCodec>> &idle_codecs = schema->idle_codecs[descriptor_id];
+        if (!idle_codecs.empty()) {
+            codec = idle_codecs.back().release();
+            idle_codecs.pop_back();
+        }
+    }
+
+    if (codec != NULL) {
+        codec->setFields(NULL);
+        codec->setDecimalOptions(DecimalOptions());
+        codec->setTypedArrays(false);
+        codec->setBinaryViews(false);
+    } else {
+        // imports module, so it's created under GIL only, not under lock
+        if (tbapi_module_ == NULL)
+            tbapi_module_ = new PythonTbApiModule();
+        codec = new MessageCodec(tbapi_module_, schema->descriptors, descriptor_id);
+    }
+
+    CodecCache *cache = this;
+    return MessageCodecPtr(codec, [cache, schema, descriptor_id](MessageCodec *released) {
+        cache->releaseCodec(schema, descriptor_id, released);
+    });
+}
+
+void CodecCache::releaseCodec(const CachedSchemaPtr &schema, intptr_t descriptor_id, MessageCodec *codec) {
+    {
+        MutexHolder mutex_holder(&lock_);
+        std::vector<std::unique_ptr<MessageCodec>> &idle_codecs = schema->idle_codecs[descriptor_id];
+        if (idle_codecs.size() < MAX_IDLE_CODECS) {
+            idle_codecs.push_back(std::unique_ptr<MessageCodec>(codec));
+            return;
+        }
+    }
+
+    delete codec;
+}
+
+}
+}
@@ -0,0 +1,61 @@
+#ifndef DELTIX_API_CODECS_CODEC_CACHE_H_
+#define DELTIX_API_CODECS_CODEC_CACHE_H_
+
+#include "Python.h"
+
+#include "python_common.h"
+#include "message_codec.h"
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace TbApiImpl {
+namespace Python {
+
+// Parsed schema text with idle codecs of its classes.
+struct CachedSchema {
+    std::string text;
+    ClassDescriptors descriptors;
+
+    // codecs released by closed cursors and loaders, by index of class descriptor
+    std::unordered_map<intptr_t, std::vector<std::unique_ptr<MessageCodec>>> idle_codecs;
+};
+
+typedef std::shared_ptr<CachedSchema> CachedSchemaPtr;
+
+// Process-wide cache of parsed schemas and message codecs, shared by all cursors and loaders.
+// Schemas are keyed by hash of schema text, codecs by schema and class.
+// Codecs are stateful, so every codec is used by one owner at a time:
+// acquired codec returns to the cache, when the last reference to it is released.
+class CodecCache {
+public:
+    static CodecCache & instance();
+
+    // returns parsed schema, schema text is parsed once per process
+    CachedSchemaPtr getSchema(const std::string &text);
+
+    // returns codec of class with all fields selected, reuses idle codec, if any
+    MessageCodecPtr acquireCodec(const CachedSchemaPtr &schema, intptr_t descriptor_id);
+
+private:
+    CodecCache();
+
+    void releaseCodec(const CachedSchemaPtr &schema, intptr_t descriptor_id, MessageCodec *codec);
+
+    DISALLOW_COPY_AND_ASSIGN(CodecCache);
+
+    std::mutex lock_;
+    std::unordered_map<size_t, std::vector<CachedSchemaPtr>> schemas_;
+    size_t schemas_count_ = 0;
+
+    // module is never released: codecs may outlive interpreter finalization in static objects
+    PythonTbApiModule *tbapi_module_ = NULL;
+};
+
+}
+}
+
+#endif // DELTIX_API_CODECS_CODEC_CACHE_H_
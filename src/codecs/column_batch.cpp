@@ -0,0 +1,406 @@
+#include "column_batch.h"
+#include "decimal64.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+
+namespace TbApiImpl {
+namespace Python {
+
+// copies values into new bytearray and returns memoryview of it cast to the format,
+// numpy.asarray() of the view shares the bytearray
+static PyObject * newTypedView(const void *data, size_t size, const char *format) {
+    PythonRefHolder bytes(PyByteArray_FromStringAndSize((const char *) data, (Py_ssize_t) size));
+    if (bytes.getReference() == NULL)
+        THROW("Can't allocate column buffer.");
+
+    PythonRefHolder view(PyMemoryView_FromObject(bytes.getReference()));
+    if (view.getReference() == NULL)
+        THROW("Can't create memoryview of column buffer.");
+
+    PyObject *typed_view = PyObject_CallMethod(view.getReference(), "cast", "s", format);
+    if (typed_view == NULL)
+        THROW_EXCEPTION("Can't cast column buffer to '%s'.", format);
+
+    return typed_view;
+}
+
+Column::Column(const std::string &name, ColumnType type) : name_(name), type_(type) {
+    if (type_ == LIST_COLUMN)
+        offsets_.push_back(0);
+}
+
+Column::~Column() {
+    clear();
+}
+
+void Column::appendObject(PyObject *value) {
+    object_values_.push_back(value);
+    nulls_.push_back(value == NULL || value == Py_None ? 1 : 0);
+}
+
+void Column::appendNull() {
+    switch (type_) {
+    case INT64_COLUMN:
+    case CATEGORY_COLUMN:
+        int_values_.push_back(0);
+        break;
+    case FLOAT64_COLUMN:
+        float_values_.push_back(std::numeric_limits<double>::quiet_NaN());
+        break;
+    case BOOLEAN_COLUMN:
+        bool_values_.push_back(0);
+        break;
+    case STRING_COLUMN:
+        string_values_.push_back(std::string());
+        break;
+    case LIST_COLUMN:
+        appendOffset();
+        break;
+    case OBJECT_COLUMN:
+        // NULL is exported as None, so nulls are appended without GIL
+        object_values_.push_back(NULL);
+        break;
+    }
+
+    nulls_.push_back(1);
+}
+
+bool Column::hasCategory(int64_t code) const {
+    return code >= 0 && code < (int64_t) categories_defined_.size() && categories_defined_[code] != 0;
+}
+
+void Column::setCategory(int64_t code, const std::string &value) {
+    if (code < 0)
+        THROW_EXCEPTION("Invalid category code %lld of column '%s'.", (long long) code, name_.c_str());
+
+    if (code >= (int64_t) categories_.size()) {
+        categories_.resize(code + 1);
+        categories_defined_.resize(code + 1, 0);
+    }
+
+    categories_[code] = value;
+    categories_defined_[code] = 1;
+}
+
+void Column::setCategories(const std::vector<std::string> &values) {
+    categories_ = values;
+    categories_defined_.assign(values.size(), 1);
+}
+
+Column & Column::setElements(ColumnType type) {
+    if (type_ != LIST_COLUMN)
+        THROW_EXCEPTION("Column '%s' is not a list column.", name_.c_str());
+
+    if (elements_ == nullptr)
+        elements_.reset(new Column("item", type));
+    else if (elements_->getType() != type)
+        THROW_EXCEPTION("Field '%s' has different types of array elements in stream schema.", name_.c_str());
+
+    return *elements_;
+}
+
+void Column::appendOffset() {
+    size_t size = elements_ != nullptr ? elements_->size() : 0;
+    if (size > (size_t) std::numeric_limits<int32_t>::max())
+        THROW_EXCEPTION("Too many array elements in column '%s'.", name_.c_str());
+
+    offsets_.push_back((int32_t) size);
+}
+
+void Column::clear() {
+    for (PyObject *object : object_values_)
+        Py_XDECREF(object);
+
+    int_values_.clear();
+    float_values_.clear();
+    bool_values_.clear();
+    string_values_.clear();
+    object_values_.clear();
+    nulls_.clear();
+    decimal_values_.clear();
+    decimal_rows_.clear();
+
+    if (type_ == LIST_COLUMN) {
+        if (elements_ != nullptr)
+            elements_->clear();
+        offsets_.assign(1, 0);
+    }
+}
+
+template <typename T>
+static void truncateValues(std::vector<T> &values, size_t size) {
+    if (values.size() > size)
+        values.resize(size);
+}
+
+void Column::truncate(size_t size) {
+    for (size_t i = size; i < object_values_.size(); ++i)
+        Py_XDECREF(object_values_[i]);
+
+    truncateValues(int_values_, size);
+    truncateValues(float_values_, size);
+    truncateValues(bool_values_, size);
+    truncateValues(string_values_, size);
+    truncateValues(object_values_, size);
+    truncateValues(nulls_, size);
+
+    // pending decimals are appended in order of rows
+    while (!decimal_rows_.empty() && decimal_rows_.back() >= size) {
+        decimal_rows_.pop_back();
+        decimal_values_.pop_back();
+    }
+
+    // elements of failed row are appended before its offset
+    if (type_ == LIST_COLUMN) {
+        truncateValues(offsets_, size + 1);
+        if (elements_ != nullptr)
+            elements_->truncate((size_t) offsets_[size]);
+    }
+}
+
+void Column::convertPendingDecimals() {
+    decimal_buffer_.resize(decimal_values_.size());
+    decodeDecimal64Array(decimal_values_.data(), decimal_buffer_.data(), decimal_values_.size());
+    for (size_t i = 0; i < decimal_rows_.size(); ++i)
+        float_values_[decimal_rows_[i]] = decimal_buffer_[i];
+
+    decimal_values_.clear();
+    decimal_rows_.clear();
+}
+
+PyObject * Column::valueToPython(size_t row) {
+    if (row >= nulls_.size())
+        THROW_EXCEPTION("Row %d is out of bounds of column '%s'.", (int) row, name_.c_str());
+
+    if (nulls_[row] && type_ != OBJECT_COLUMN)
+        Py_RETURN_NONE;
+
+    convertDecimals();
+
+    switch (type_) {
+    case INT64_COLUMN:
+        return PyLong_FromLongLong(int_values_[row]);
+    case FLOAT64_COLUMN:
+        return PyFloat_FromDouble(float_values_[row]);
+    case BOOLEAN_COLUMN:
+        return PyBool_FromLong(bool_values_[row]);
+    case STRING_COLUMN:
+        return PyUnicode_DecodeUTF8(string_values_[row].c_str(), string_values_[row].size(), "ignore");
+    case CATEGORY_COLUMN: {
+        int64_t code = int_values_[row];
+        if (!hasCategory(code))
+            Py_RETURN_NONE;
+        return PyUnicode_DecodeUTF8(categories_[code].c_str(), categories_[code].size(), "ignore");
+    }
+    case LIST_COLUMN:
+        return listToPython(row);
+    case OBJECT_COLUMN: {
+        PyObject *object = object_values_[row] != NULL ? object_values_[row] : Py_None;
+        Py_INCREF(object);
+        return object;
+    }
+    }
+
+    Py_RETURN_NONE;
+}
+
+// returns list of elements of the row, typed memoryview if lists are typed
+// (integer and boolean lists with nulls are returned as python lists)
+PyObject * Column::listToPython(size_t row) {
+    size_t begin = (size_t) offsets_[row];
+    size_t size = (size_t) offsets_[row + 1] - begin;
+
+    const uint8_t *nulls = elements_->getNulls().data() + begin;
+    bool has_nulls = std::find(nulls, nulls + size, 1) != nulls + size;
+    if (typed_lists_) {
+        switch (elements_->getType()) {
+        case FLOAT64_COLUMN:
+            return newTypedView(elements_->getFloat64Values().data() + begin, size * sizeof(double), "d");
+        case INT64_COLUMN:
+            if (!has_nulls)
+                return newTypedView(elements_->getInt64Values().data() + begin, size * sizeof(int64_t), "q");
+            break;
+        case BOOLEAN_COLUMN:
+            if (!has_nulls)
+                return newTypedView(elements_->getBooleanValues().data() + begin, size, "?");
+            break;
+        default:
+            break;
+        }
+    }
+
+    PyObject *list = PyList_New(size);
+    for (size_t i = 0; i < size; ++i)
+        PyList_SET_ITEM(list, i, elements_->valueToPython(begin + i));
+    return list;
+}
+
+PyObject * Column::valuesToPython() {
+    switch (type_) {
+    case INT64_COLUMN:
+    case CATEGORY_COLUMN:
+        return newTypedView(int_values_.data(), int_values_.size() * sizeof(int64_t), "q");
+    case FLOAT64_COLUMN:
+        convertDecimals();
+        return newTypedView(float_values_.data(), float_values_.size() * sizeof(double), "d");
+    case BOOLEAN_COLUMN:
+        return newTypedView(bool_values_.data(), bool_values_.size(), "?");
+    case STRING_COLUMN: {
+        PyObject *list = PyList_New(string_values_.size());
+        for (size_t i = 0; i < string_values_.size(); ++i) {
+            if (nulls_[i]) {
+                Py_INCREF(Py_None);
+                PyList_SET_ITEM(list, i, Py_None);
+            } else {
+                PyList_SET_ITEM(list, i,
+                    PyUnicode_DecodeUTF8(string_values_[i].c_str(), string_values_[i].size(), "ignore"));
+            }
+        }
+        return list;
+    }
+    case LIST_COLUMN: {
+        PyObject *list = PyList_New(size());
+        for (size_t i = 0; i < size(); ++i)
+            PyList_SET_ITEM(list, i, valueToPython(i));
+        return list;
+    }
+    case OBJECT_COLUMN: {
+        PyObject *list = PyList_New(object_values_.size());
+        for (size_t i = 0; i < object_values_.size(); ++i) {
+            PyObject *object = object_values_[i] != NULL ? object_values_[i] : Py_None;
+            Py_INCREF(object);
+            PyList_SET_ITEM(list, i, object);
+        }
+        return list;
+    }
+    }
+
+    Py_RETURN_NONE;
+}
+
+PyObject * Column::nullsToPython() {
+    return newTypedView(nulls_.data(), nulls_.size(), "?");
+}
+
+PyObject * Column::categoriesToPython() {
+    PyObject *list = PyList_New(categories_.size());
+    for (size_t i = 0; i < categories_.size(); ++i) {
+        if (categories_defined_[i]) {
+            PyList_SET_ITEM(list, i,
+                PyUnicode_DecodeUTF8(categories_[i].c_str(), categories_[i].size(), "ignore"));
+        } else {
+            Py_INCREF(Py_None);
+            PyList_SET_ITEM(list, i, Py_None);
+        }
+    }
+    return list;
+}
+
+static std::atomic<uint64_t> last_batch_id(0);
+
+ColumnBatch::ColumnBatch() : id_(++last_batch_id) {
+}
+
+ColumnBatch::~ColumnBatch() {
+}
+
+void ColumnBatch::setFields(const std::vector<std::string> &fields) {
+    if (!columns_.empty())
+        THROW("Can't select fields of batch with decoded columns.");
+
+    fields_.clear();
+    fields_.insert(fields.begin(), fields.end());
+    all_fields_ = false;
+}
+
+Column * ColumnBatch::getColumn(const std::string &name, ColumnType type) {
+    if (!all_fields_ && fields_.find(name) == fields_.end())
+        return NULL;
+
+    auto it = columns_map_.find(name);
+    if (it != columns_map_.end()) {
+        if (it->second->getType() != type)
+            THROW_EXCEPTION("Field '%s' has different types in stream schema.", name.c_str());
+
+        return it->second;
+    }
+
+    Column *column = new Column(name, type);
+    columns_.push_back(std::unique_ptr<Column>(column));
+    columns_map_[name] = column;
+
+    // column appeared in the middle of batch, previous rows are nulls
+    for (size_t i = 0; i < size_; ++i)
+        column->appendNull();
+
+    return column;
+}
+
+Column * ColumnBatch::findColumn(const std::string &name) {
+    auto it = columns_map_.find(name);
+    return it != columns_map_.end() ? it->second : NULL;
+}
+
+void ColumnBatch::endRow() {
+    ++size_;
+    for (size_t i = 0; i < columns_.size(); ++i) {
+        Column *column = columns_[i].get();
+        if (column->size() < size_)
+            column->appendNull();
+    }
+}
+
+void ColumnBatch::discardRow() {
+    for (size_t i = 0; i < columns_.size(); ++i)
+        columns_[i]->truncate(size_);
+}
+
+void ColumnBatch::clear() {
+    for (size_t i = 0; i < columns_.size(); ++i)
+        columns_[i]->clear();
+    size_ = 0;
+}
+
+PyObject * ColumnBatch::toPython() {
+    PythonRefHolder columns(PyDict_New());
+    PythonRefHolder nulls(PyDict_New());
+    PythonRefHolder categories(PyDict_New());
+
+    for (size_t i = 0; i < columns_.size(); ++i) {
+        Column *column = columns_[i].get();
+        const char *name = column->getName().c_str();
+
+        PythonRefHolder values(column->valuesToPython());
+        PyDict_SetItemString(columns.getReference(), name, values.getReference());
+
+        PythonRefHolder column_nulls(column->nullsToPython());
+        PyDict_SetItemString(nulls.getReference(), name, column_nulls.getReference());
+
+        if (column->getType() == CATEGORY_COLUMN) {
+            PythonRefHolder column_categories(column->categoriesToPython());
+            PyDict_SetItemString(categories.getReference(), name, column_categories.getReference());
+        }
+    }
+
+    return Py_BuildValue("(nOOO)", (Py_ssize_t) size_,
+        columns.getReference(), nulls.getReference(), categories.getReference());
+}
+
+PyObject * ColumnBatch::rowToPython(size_t row) {
+    PythonRefHolder values(PyDict_New());
+    for (size_t i = 0; i < columns_.size(); ++i) {
+        Column *column = columns_[i].get();
+        PythonRefHolder value(column->valueToPython(row));
+        PyDict_SetItemString(values.getReference(), column->getName().c_str(), value.getReference());
+    }
+
+    PyObject *result = values.getReference();
+    Py_INCREF(result);
+    return result;
+}
+
+}
+}
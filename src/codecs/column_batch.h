@@ -0,0 +1,254 @@
+#ifndef DELTIX_API_CODECS_COLUMN_BATCH_H_
+#define DELTIX_API_CODECS_COLUMN_BATCH_H_
+
+#include "Python.h"
+
+#include "python_common.h"
+#include "dxapi.h"
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace TbApiImpl {
+namespace Python {
+
+enum ColumnType {
+    INT64_COLUMN, FLOAT64_COLUMN, BOOLEAN_COLUMN, STRING_COLUMN, CATEGORY_COLUMN, LIST_COLUMN, OBJECT_COLUMN
+};
+
+// Growable typed buffer with values of one field.
+// Numeric columns are exported to python as typed memoryviews (int64 'q', float64 'd', bool '?')
+// over copies of their values,
+// category columns as int64 codes plus list of categories, other columns as python lists.
+// List columns keep elements of all rows in column of elements and offsets of rows in it.
+class Column {
+public:
+    Column(const std::string &name, ColumnType type);
+    ~Column();
+
+    inline void appendInt64(int64_t value) {
+        int_values_.push_back(value);
+        nulls_.push_back(0);
+    }
+
+    inline void appendFloat64(double value) {
+        float_values_.push_back(value);
+        nulls_.push_back(0);
+    }
+
+    // raw decimal values are converted to doubles in bulk, when column values are read
+    inline void appendDecimal64(int64_t value) {
+        decimal_rows_.push_back(float_values_.size());
+        decimal_values_.push_back(value);
+        float_values_.push_back(0);
+        nulls_.push_back(0);
+    }
+
+    inline void appendBoolean(bool value) {
+        bool_values_.push_back(value ? 1 : 0);
+        nulls_.push_back(0);
+    }
+
+    inline void appendString(const std::string &value) {
+        string_values_.push_back(value);
+        nulls_.push_back(0);
+    }
+
+    inline void appendCategory(int64_t code) {
+        int_values_.push_back(code);
+        nulls_.push_back(0);
+    }
+
+    // elements of list are appended to getElements() before the list
+    inline void endList() {
+        appendOffset();
+        nulls_.push_back(0);
+    }
+
+    // steals reference
+    void appendObject(PyObject *value);
+    // doesn't require GIL, also for object columns
+    void appendNull();
+
+    bool hasCategory(int64_t code) const;
+    void setCategory(int64_t code, const std::string &value);
+    void setCategories(const std::vector<std::string> &values);
+
+    // creates column of elements of list column, returns existing column of the same type
+    Column & setElements(ColumnType type);
+
+    // NULL, if column is not a list column or elements are not set
+    Column * getElements() {
+        return elements_.get();
+    }
+
+    // lists of numeric elements are exported to python as typed memoryviews (see ArrayFieldCodec)
+    void setTypedLists(bool typed) {
+        typed_lists_ = typed;
+    }
+
+    const std::string & getName() const {
+        return name_;
+    }
+
+    ColumnType getType() const {
+        return type_;
+    }
+
+    size_t size() const {
+        return nulls_.size();
+    }
+
+    // arrow format of column values, if it differs from format of column type (e.g. timestamps)
+    void setArrowFormat(const char *format) {
+        arrow_format_ = format;
+    }
+
+    const char * getArrowFormat() const {
+        return arrow_format_;
+    }
+
+    // buffers of column for export, values may be moved out only before clear()
+    std::vector<int64_t> & getInt64Values() {
+        return int_values_;
+    }
+
+    std::vector<double> & getFloat64Values() {
+        convertDecimals();
+        return float_values_;
+    }
+
+    const std::vector<uint8_t> & getBooleanValues() const {
+        return bool_values_;
+    }
+
+    const std::vector<std::string> & getStringValues() const {
+        return string_values_;
+    }
+
+    const std::vector<uint8_t> & getNulls() const {
+        return nulls_;
+    }
+
+    const std::vector<std::string> & getCategories() const {
+        return categories_;
+    }
+
+    // offsets of rows of list column in elements, size() + 1 values
+    std::vector<int32_t> & getOffsets() {
+        return offsets_;
+    }
+
+    void clear();
+
+    // removes values of rows starting with size (python objects are released, GIL is required for object columns)
+    void truncate(size_t size);
+
+    // returns new reference to python object of value in the row
+    PyObject * valueToPython(size_t row);
+    PyObject * valuesToPython();
+    PyObject * nullsToPython();
+    PyObject * categoriesToPython();
+
+private:
+    DISALLOW_COPY_AND_ASSIGN(Column);
+
+    inline void convertDecimals() {
+        if (!decimal_values_.empty())
+            convertPendingDecimals();
+    }
+
+    void convertPendingDecimals();
+
+    void appendOffset();
+    PyObject * listToPython(size_t row);
+
+    std::string name_;
+    ColumnType type_;
+    const char *arrow_format_ = NULL;
+
+    std::vector<int64_t> int_values_;
+    std::vector<double> float_values_;
+    std::vector<uint8_t> bool_values_;
+    std::vector<std::string> string_values_;
+    std::vector<PyObject *> object_values_;
+    std::vector<uint8_t> nulls_;
+
+    // decimals appended since last conversion and their rows in float_values_
+    std::vector<int64_t> decimal_values_;
+    std::vector<size_t> decimal_rows_;
+    std::vector<double> decimal_buffer_;
+
+    std::vector<std::string> categories_;
+    std::vector<uint8_t> categories_defined_;
+
+    std::unique_ptr<Column> elements_;
+    std::vector<int32_t> offsets_;
+    bool typed_lists_ = false;
+};
+
+// Set of columns filled row by row. Columns which are not filled in a row are padded with nulls,
+// so rows of different message types (polymorphic streams) are aligned.
+class ColumnBatch {
+public:
+    ColumnBatch();
+    ~ColumnBatch();
+
+    // restricts batch to the given fields, other fields are not decoded
+    void setFields(const std::vector<std::string> &fields);
+
+    // returns NULL, if field is not selected
+    Column * getColumn(const std::string &name, ColumnType type);
+
+    // returns NULL, if column doesn't exist
+    Column * findColumn(const std::string &name);
+
+    // unique id of batch, codecs use it to find out that bound columns are still valid
+    uint64_t getId() const {
+        return id_;
+    }
+
+    void endRow();
+
+    // removes values of the row, which is not ended by endRow() (decoding of message failed),
+    // so columns stay aligned with rows of batch
+    void discardRow();
+
+    size_t size() const {
+        return size_;
+    }
+
+    size_t getColumnsCount() const {
+        return columns_.size();
+    }
+
+    Column * columnAt(size_t index) {
+        return columns_[index].get();
+    }
+
+    void clear();
+
+    // returns tuple (size, columns, nulls, categories)
+    PyObject * toPython();
+
+    // returns dictionary with values of the row
+    PyObject * rowToPython(size_t row);
+
+private:
+    DISALLOW_COPY_AND_ASSIGN(ColumnBatch);
+
+    std::vector<std::unique_ptr<Column>> columns_;
+    std::unordered_map<std::string, Column *> columns_map_;
+    std::unordered_set<std::string> fields_;
+    bool all_fields_ = true;
+    size_t size_ = 0;
+    uint64_t id_;
+};
+
+}
+}
+
+#endif //DELTIX_API_CODECS_COLUMN_BATCH_H_
@@ -0,0 +1,101 @@
+#include "column_source.h"
+
+namespace TbApiImpl {
+namespace Python {
+
+ColumnSource::ColumnSource(const std::string &name, PyObject *values) : name_(name) {
+    buffer_.obj = NULL;
+    if (initBuffer(values))
+        return;
+
+    // lists are copied: loaders release GIL, while rows are sent, so lists can be changed by other threads
+    sequence_ = PyList_Check(values) ? PyList_AsTuple(values) : PySequence_Fast(values, "");
+    if (sequence_ == NULL) {
+        PyErr_Clear();
+        THROW_EXCEPTION("Values of column '%s' should be a sequence or a numeric buffer.", name_.c_str());
+    }
+
+    size_ = (size_t) PySequence_Fast_GET_SIZE(sequence_);
+}
+
+ColumnSource::~ColumnSource() {
+    if (buffer_.obj != NULL)
+        PyBuffer_Release(&buffer_);
+    Py_XDECREF(sequence_);
+}
+
+// returns false, if values are not a one-dimensional numeric buffer
+bool ColumnSource::initBuffer(PyObject *values) {
+    if (!PyObject_CheckBuffer(values) || PyBytes_Check(values) || PyByteArray_Check(values))
+        return false;
+
+    if (PyObject_GetBuffer(values, &buffer_, PyBUF_STRIDES | PyBUF_FORMAT) != 0) {
+        // numpy arrays of objects, strings or datetimes don't export typed buffers
+        PyErr_Clear();
+        buffer_.obj = NULL;
+        return false;
+    }
+
+    const char *format = buffer_.format != NULL ? buffer_.format : "B";
+    if (*format == '@' || *format == '=' || *format == '<')
+        ++format;
+
+    Kind kind = SEQUENCE_KIND;
+    if (format[0] != 0 && format[1] == 0) {
+        switch (format[0]) {
+        case 'b': case 'h': case 'i': case 'l': case 'q': case 'n':
+            kind = INT_KIND;
+            break;
+        case 'B': case 'H': case 'I': case 'L': case 'Q': case 'N': case '?':
+            kind = UINT_KIND;
+            break;
+        case 'f': case 'd':
+            kind = FLOAT_KIND;
+            break;
+        }
+    }
+
+    bool supported_size = buffer_.itemsize == 1 || buffer_.itemsize == 2 ||
+        buffer_.itemsize == 4 || buffer_.itemsize == 8;
+    if (kind == FLOAT_KIND)
+        supported_size = buffer_.itemsize == 4 || buffer_.itemsize == 8;
+
+    int ndim = buffer_.ndim;
+    if (kind == SEQUENCE_KIND || !supported_size || ndim != 1) {
+        PyBuffer_Release(&buffer_);
+        buffer_.obj = NULL;
+        if (kind != SEQUENCE_KIND && ndim != 1)
+            THROW_EXCEPTION("Values of column '%s' should be one-dimensional.", name_.c_str());
+        return false;
+    }
+
+    kind_ = kind;
+    boolean_ = format[0] == '?';
+    item_size_ = buffer_.itemsize;
+    stride_ = buffer_.strides != NULL ? buffer_.strides[0] : buffer_.itemsize;
+    size_ = (size_t) buffer_.shape[0];
+    return true;
+}
+
+PyObject * ColumnSource::getObject(size_t row) const {
+    switch (kind_) {
+    case SEQUENCE_KIND: {
+        PyObject *item = PySequence_Fast_GET_ITEM(sequence_, row);
+        Py_INCREF(item);
+        return item;
+    }
+    case FLOAT_KIND: {
+        double value;
+        if (!getFloat64(row, value))
+            Py_RETURN_NONE;
+        return PyFloat_FromDouble(value);
+    }
+    case UINT_KIND:
+        return PyLong_FromUnsignedLongLong(readUnsigned((const char *) buffer_.buf + row * stride_));
+    default:
+        return PyLong_FromLongLong(readSigned((const char *) buffer_.buf + row * stride_));
+    }
+}
+
+}
+}
@@ -0,0 +1,136 @@
+#ifndef DELTIX_API_CODECS_COLUMN_SOURCE_H_
+#define DELTIX_API_CODECS_COLUMN_SOURCE_H_
+
+#include "Python.h"
+
+#include "python_common.h"
+#include "dxapi.h"
+
+#include <string>
+
+namespace TbApiImpl {
+namespace Python {
+
+// Values of one field for columnar encoding.
+// One-dimensional numeric buffers (numpy arrays, array.array, typed memoryviews) are read in place
+// through the buffer protocol, other objects are read as python sequences.
+class ColumnSource {
+public:
+    ColumnSource(const std::string &name, PyObject *values);
+    ~ColumnSource();
+
+    inline size_t size() const {
+        return size_;
+    }
+
+    inline bool isNumeric() const {
+        return kind_ != SEQUENCE_KIND;
+    }
+
+    // numeric sources only, type of buffer items
+    inline bool isInteger() const {
+        return (kind_ == INT_KIND || kind_ == UINT_KIND) && !boolean_;
+    }
+
+    inline bool isFloat() const {
+        return kind_ == FLOAT_KIND;
+    }
+
+    inline bool isBoolean() const {
+        return boolean_;
+    }
+
+    // numeric sources only, returns false for NaN values of float buffers
+    inline bool getInt64(size_t row, int64_t &value) const {
+        const char *item = (const char *) buffer_.buf + row * stride_;
+        switch (kind_) {
+        case INT_KIND:
+            value = readSigned(item);
+            return true;
+        case UINT_KIND:
+            value = (int64_t) readUnsigned(item);
+            return true;
+        case FLOAT_KIND: {
+            double float_value = readFloat(item);
+            if (float_value != float_value)
+                return false;
+            value = (int64_t) float_value;
+            return true;
+        }
+        default:
+            return false;
+        }
+    }
+
+    // numeric sources only, returns false for NaN values
+    inline bool getFloat64(size_t row, double &value) const {
+        const char *item = (const char *) buffer_.buf + row * stride_;
+        switch (kind_) {
+        case INT_KIND:
+            value = (double) readSigned(item);
+            return true;
+        case UINT_KIND:
+            value = (double) readUnsigned(item);
+            return true;
+        case FLOAT_KIND:
+            value = readFloat(item);
+            return value == value;
+        default:
+            return false;
+        }
+    }
+
+    // returns new reference to value of row
+    PyObject * getObject(size_t row) const;
+
+    const std::string & getName() const {
+        return name_;
+    }
+
+private:
+    enum Kind {
+        SEQUENCE_KIND, INT_KIND, UINT_KIND, FLOAT_KIND
+    };
+
+    bool initBuffer(PyObject *values);
+
+    inline int64_t readSigned(const char *item) const {
+        switch (item_size_) {
+        case 1: return *(const int8_t *) item;
+        case 2: return *(const int16_t *) item;
+        case 4: return *(const int32_t *) item;
+        default: return *(const int64_t *) item;
+        }
+    }
+
+    inline uint64_t readUnsigned(const char *item) const {
+        switch (item_size_) {
+        case 1: return *(const uint8_t *) item;
+        case 2: return *(const uint16_t *) item;
+        case 4: return *(const uint32_t *) item;
+        default: return *(const uint64_t *) item;
+        }
+    }
+
+    inline double readFloat(const char *item) const {
+        if (item_size_ == 4)
+            return *(const float *) item;
+        return *(const double *) item;
+    }
+
+    DISALLOW_COPY_AND_ASSIGN(ColumnSource);
+
+    std::string name_;
+    Kind kind_ = SEQUENCE_KIND;
+    Py_buffer buffer_;
+    Py_ssize_t stride_ = 0;
+    Py_ssize_t item_size_ = 0;
+    bool boolean_ = false;
+    PyObject *sequence_ = NULL;
+    size_t size_ = 0;
+};
+
+}
+}
+
+#endif // DELTIX_API_CODECS_COLUMN_SOURCE_H_
@@ -0,0 +1,159 @@
+#include "decimal64.h"
+
+#include <cstring>
+#include <limits>
+
+#if defined(__APPLE__)
+extern "C" double toFloat64(uint64_t value);
+extern "C" uint64_t fromFloat64(double value);
+#else
+extern "C" double decimal_native_toFloat64(uint64_t value);
+extern "C" uint64_t decimal_native_fromFloat64(double value);
+#endif
+
+namespace TbApiImpl {
+namespace Python {
+
+#if defined(__APPLE__)
+double dfp_toDouble(uint64_t value) {
+    return toFloat64(value);
+}
+
+uint64_t dfp_fromDouble(double value) {
+    return fromFloat64(value);
+}
+#else
+double dfp_toDouble(uint64_t value) {
+    return decimal_native_toFloat64(value);
+}
+
+uint64_t dfp_fromDouble(double value) {
+    return decimal_native_fromFloat64(value);
+}
+#endif
+
+const double EXACT_POW10[MAX_EXACT_POW10 + 1] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+// coefficients of canonical values have at most 16 digits, non-canonical values are zeros
+static const uint64_t MAX_DECIMAL64_COEFFICIENT = 9999999999999999ULL;
+
+static const uint64_t UINT64_POW10[] = {
+    1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL,
+    1000000000ULL, 10000000000ULL, 100000000000ULL, 1000000000000ULL, 10000000000000ULL,
+    100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL, 100000000000000000ULL,
+    1000000000000000000ULL, 10000000000000000000ULL
+};
+
+void unpackDecimal64(int64_t value, bool &negative, uint64_t &coefficient, int32_t &exponent) {
+    uint64_t bits = (uint64_t) value;
+    negative = (bits >> 63) != 0;
+    if ((bits & DECIMAL64_SPECIAL_MASK) != DECIMAL64_SPECIAL_MASK) {
+        coefficient = bits & DECIMAL64_COEFFICIENT_MASK;
+        exponent = (int32_t) ((bits >> 53) & 0x3FF) - DECIMAL64_EXPONENT_BIAS;
+    } else {
+        // large coefficients have implicit '100' prefix and 51 bits of value
+        coefficient = (bits & 0x0007FFFFFFFFFFFFULL) | 0x0020000000000000ULL;
+        exponent = (int32_t) ((bits >> 51) & 0x3FF) - DECIMAL64_EXPONENT_BIAS;
+    }
+
+    if (coefficient > MAX_DECIMAL64_COEFFICIENT)
+        coefficient = 0;
+}
+
+bool decimal64ToFixed(int64_t value, int32_t scale, int64_t &result) {
+    bool negative;
+    uint64_t coefficient;
+    int32_t exponent;
+    unpackDecimal64(value, negative, coefficient, exponent);
+
+    int32_t shift = exponent + scale;
+    uint64_t magnitude;
+    if (coefficient == 0) {
+        magnitude = 0;
+    } else if (shift >= 0) {
+        if (shift > 18 || coefficient > (uint64_t) INT64_MAX / UINT64_POW10[shift])
+            return false;
+        magnitude = coefficient * UINT64_POW10[shift];
+    } else if (shift < -17) {
+        // coefficient is less than half of divisor
+        magnitude = 0;
+    } else {
+        uint64_t divisor = UINT64_POW10[-shift];
+        magnitude = coefficient / divisor;
+        uint64_t remainder = coefficient % divisor;
+        if (remainder * 2 > divisor || (remainder * 2 == divisor && (magnitude & 1) != 0))
+            ++magnitude;
+    }
+
+    if (magnitude > (uint64_t) INT64_MAX)
+        return false;
+
+    result = negative ? -(int64_t) magnitude : (int64_t) magnitude;
+    return true;
+}
+
+// coefficient is converted to double by 2^52 magic number: low 52 bits of coefficient are mantissa of 2^52 + low,
+// high bit is converted in the same way, so no int64 to double conversion (AVX-512 only) is required
+static const uint64_t MAGIC_2P52_BITS = 0x4330000000000000ULL;
+static const double MAGIC_2P52 = 4503599627370496.0;
+static const uint64_t MANTISSA_MASK = 0x000FFFFFFFFFFFFFULL;
+static const uint64_t SIGN_MASK = 0x8000000000000000ULL;
+
+// exact powers of ten, which are indexed by masked scale without branches (tail is used only by slow values)
+static const size_t SCALE_INDEX_MASK = 31;
+static const double SCALE_POW10[SCALE_INDEX_MASK + 1] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+    1, 1, 1, 1, 1, 1, 1, 1, 1
+};
+
+static inline double bitsToDouble(uint64_t bits) {
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+static inline uint64_t doubleToBits(double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+void decodeDecimal64Array(const int64_t * __restrict values, double * __restrict result, size_t size) {
+    // first pass has no branches and calls, coefficients of fast path are less than 2^53 and are converted exactly;
+    // GCC vectorizes it with SSE4.2 or AVX2 (-march), values out of fast path are converted by DFP library in second pass
+    int has_slow_values = 0;
+    for (size_t i = 0; i < size; ++i) {
+        uint64_t bits = (uint64_t) values[i];
+        uint64_t scale = (uint64_t) (DECIMAL64_EXPONENT_BIAS - (int64_t) ((bits >> 53) & 0x3FF));
+        bool special = (bits & DECIMAL64_SPECIAL_MASK) == DECIMAL64_SPECIAL_MASK;
+        bool exact = scale <= MAX_EXACT_POW10;
+
+        uint64_t coefficient = bits & DECIMAL64_COEFFICIENT_MASK;
+        double low = bitsToDouble(MAGIC_2P52_BITS | (coefficient & MANTISSA_MASK)) - MAGIC_2P52;
+        double high = bitsToDouble(MAGIC_2P52_BITS | (coefficient >> 52)) - MAGIC_2P52;
+        double magnitude = (low + high * MAGIC_2P52) / SCALE_POW10[scale & SCALE_INDEX_MASK];
+        result[i] = bitsToDouble(doubleToBits(magnitude) | (bits & SIGN_MASK));
+        has_slow_values |= special | !exact;
+    }
+
+    if (!has_slow_values)
+        return;
+
+    for (size_t i = 0; i < size; ++i) {
+        uint64_t bits = (uint64_t) values[i];
+        if (getDecimal64FastScale(bits) >= 0)
+            continue;
+
+        if (values[i] == DECIMAL64_NULL)
+            result[i] = std::numeric_limits<double>::quiet_NaN();
+        else
+            result[i] = dfp_toDouble(bits);
+    }
+}
+
+}
+}
@@ -0,0 +1,97 @@
+#ifndef DELTIX_API_CODECS_DECIMAL64_H_
+#define DELTIX_API_CODECS_DECIMAL64_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+namespace TbApiImpl {
+namespace Python {
+
+// python representation of decoded Decimal64 values
+enum DecimalMode {
+    DECIMAL_FLOAT,      // float, nearest double value
+    DECIMAL_RAW,        // int, 64-bit DFP encoding of value
+    DECIMAL_FIXED,      // int, value multiplied by 10^scale and rounded half to even
+    DECIMAL_OBJECT      // decimal.Decimal with exact value
+};
+
+const int32_t MAX_DECIMAL_SCALE = 18;
+
+struct DecimalOptions {
+    DecimalMode mode = DECIMAL_FLOAT;
+
+    // scale of fixed-point values, scales of fields override default scale
+    int32_t scale = 0;
+    std::unordered_map<std::string, int32_t> field_scales;
+
+    int32_t getScale(const std::string &field_name) const {
+        auto it = field_scales.find(field_name);
+        return it != field_scales.end() ? it->second : scale;
+    }
+};
+
+// conversions of DFP library (libDecimalNative)
+double dfp_toDouble(uint64_t value);
+uint64_t dfp_fromDouble(double value);
+
+const int64_t DECIMAL64_NULL = 0xFFFFFFFFFFFFFF80LL; // = -0x80L;
+
+// Decimal64 is BID encoded: sign bit, 10 bits of biased exponent, 53 bits of coefficient
+// (when both bits after sign are not set, other values use large coefficients, infinities and NaNs).
+const uint64_t DECIMAL64_SPECIAL_MASK = 0x6000000000000000ULL;
+const uint64_t DECIMAL64_COEFFICIENT_MASK = 0x001FFFFFFFFFFFFFULL;
+const int DECIMAL64_EXPONENT_BIAS = 398;
+
+// powers of ten, which are exact doubles
+const int MAX_EXACT_POW10 = 22;
+extern const double EXACT_POW10[MAX_EXACT_POW10 + 1];
+
+// returns scale (negated exponent) of value, if value is converted to double exactly
+// by division of coefficient by power of ten, -1 otherwise
+inline int getDecimal64FastScale(uint64_t bits) {
+    if ((bits & DECIMAL64_SPECIAL_MASK) == DECIMAL64_SPECIAL_MASK)
+        return -1;
+
+    int scale = DECIMAL64_EXPONENT_BIAS - (int) ((bits >> 53) & 0x3FF);
+    return scale >= 0 && scale <= MAX_EXACT_POW10 ? scale : -1;
+}
+
+// coefficient and power of ten are exact doubles, so division is rounded like DFP library conversion
+inline double decodeDecimal64(int64_t value) {
+    uint64_t bits = (uint64_t) value;
+    int scale = getDecimal64FastScale(bits);
+    if (scale < 0)
+        return dfp_toDouble(bits);
+
+    double magnitude = (double) (bits & DECIMAL64_COEFFICIENT_MASK) / EXACT_POW10[scale];
+    return (bits >> 63) != 0 ? -magnitude : magnitude;
+}
+
+inline int64_t encodeDecimal64(double value) {
+    return (int64_t) dfp_fromDouble(value);
+}
+
+// infinities and NaNs (including null) are not finite
+inline bool isDecimal64Finite(int64_t value) {
+    return ((uint64_t) value & 0x7800000000000000ULL) != 0x7800000000000000ULL;
+}
+
+inline bool isDecimal64Infinity(int64_t value) {
+    return ((uint64_t) value & 0x7C00000000000000ULL) == 0x7800000000000000ULL;
+}
+
+// splits finite value into sign, coefficient and exponent: value = (-1)^negative * coefficient * 10^exponent
+void unpackDecimal64(int64_t value, bool &negative, uint64_t &coefficient, int32_t &exponent);
+
+// converts finite value to integer value * 10^scale, returns false if result doesn't fit int64
+bool decimal64ToFixed(int64_t value, int32_t scale, int64_t &result);
+
+// converts array of decimals, nulls are converted to NaN
+void decodeDecimal64Array(const int64_t *values, double *result, size_t size);
+
+}
+}
+
+#endif // DELTIX_API_CODECS_DECIMAL64_H_
@@ -7,38 +7,70 @@
 #include "schema.h"
 
 #include "message_codec.h"
+#include "column_batch.h"
+#include "column_source.h"
+#include "decimal64.h"
+#include "binary_buffer.h"
 
 #include <algorithm>
 #include <memory>
+#include <utility>
 
+namespace TbApiImpl {
+namespace Python {
 
-#if defined(__APPLE__)
-extern "C" double toFloat64(uint64_t value);
-extern "C" uint64_t fromFloat64(double value);
-
-double dfp_toDouble(uint64_t value) {
-    return toFloat64(value);
-}
+#define FORWARD_FIELD_WRITE(METHOD) \
+    template <typename... ARGS> \
+    inline void METHOD(ARGS &&... args) { \
+        if (writer_ != NULL) \
+            writer_->METHOD(std::forward<ARGS>(args)...); \
+    }
 
-uint64_t dfp_fromDouble(double value) {
-    return fromFloat64(value);
-}
-#else
-extern "C" double decimal_native_toFloat64(uint64_t value);
-extern "C" uint64_t decimal_native_fromFloat64(double value);
+// Writer of encoded fields. Writer without DataWriter only validates values: codecs run the same checks,
+// so values are validated before loader starts message and encoding of validated values doesn't fail.
+class FieldWriter {
+public:
+    FieldWriter(DxApi::DataWriter *writer) : writer_(writer) {
+    }
 
-double dfp_toDouble(uint64_t value) {
-    return decimal_native_toFloat64(value);
-}
+    FORWARD_FIELD_WRITE(writeInt8)
+    FORWARD_FIELD_WRITE(writeInt16)
+    FORWARD_FIELD_WRITE(writeInt32)
+    FORWARD_FIELD_WRITE(writeInt48)
+    FORWARD_FIELD_WRITE(writeInt64)
+    FORWARD_FIELD_WRITE(writePUInt30)
+    FORWARD_FIELD_WRITE(writePUInt61)
+    FORWARD_FIELD_WRITE(writeFloat32)
+    FORWARD_FIELD_WRITE(writeFloat64)
+    FORWARD_FIELD_WRITE(writeDecimal)
+    FORWARD_FIELD_WRITE(writeInterval)
+    FORWARD_FIELD_WRITE(writeTimeOfDay)
+    FORWARD_FIELD_WRITE(writeTimestamp)
+    FORWARD_FIELD_WRITE(writeBinaryArray)
+    FORWARD_FIELD_WRITE(writeBinaryArrayNull)
+    FORWARD_FIELD_WRITE(writeBoolean)
+    FORWARD_FIELD_WRITE(writeNullableBoolean)
+    FORWARD_FIELD_WRITE(writeWChar)
+    FORWARD_FIELD_WRITE(writeUTF8)
+    FORWARD_FIELD_WRITE(writeAscii)
+    FORWARD_FIELD_WRITE(writeAlphanumeric)
+    FORWARD_FIELD_WRITE(writeAlphanumericNull)
+    FORWARD_FIELD_WRITE(writeEnum8)
+    FORWARD_FIELD_WRITE(writeEnum16)
+    FORWARD_FIELD_WRITE(writeEnum32)
+    FORWARD_FIELD_WRITE(writeEnum64)
+    FORWARD_FIELD_WRITE(writeArrayStart)
+    FORWARD_FIELD_WRITE(writeArrayEnd)
+    FORWARD_FIELD_WRITE(writeArrayNull)
+    FORWARD_FIELD_WRITE(writeObjectStart)
+    FORWARD_FIELD_WRITE(writeObjectEnd)
+    FORWARD_FIELD_WRITE(writeObjectNull)
 
-uint64_t dfp_fromDouble(double value) {
-    return decimal_native_fromFloat64(value);
-}
-#endif
+private:
+    DxApi::DataWriter *writer_;
+};
 
-
-namespace TbApiImpl {
-namespace Python {
+#undef FORWARD_FIELD_WRITE
 
 class FieldCodec {
 protected:
@@ -58,7 +90,47 @@ protected:
 
 public:
     virtual PyObject * decode(DxApi::DataReader &reader) = 0;
-    virtual void encode(PyObject *field_value, DxApi::DataWriter &writer) = 0;
+    virtual void encode(PyObject *field_value, FieldWriter &writer) = 0;
+
+    virtual ColumnType getColumnType() {
+        return OBJECT_COLUMN;
+    }
+
+    virtual void initColumn(Column &column) {
+    }
+
+    // appends decoded value to the column of getColumnType() type
+    virtual void decodeColumn(DxApi::DataReader &reader, Column &column) {
+        column.appendObject(decode(reader));
+    }
+
+    // reads value of field without creating python object
+    virtual void skip(DxApi::DataReader &reader) {
+        PythonRefHolder value(decode(reader));
+    }
+
+    // type of values, which are encoded by encodeColumn() from numeric sources
+    virtual ColumnType getEncodeColumnType() {
+        return getColumnType();
+    }
+
+    // encodes value of the row of column, numeric codecs read numeric sources without python objects
+    virtual void encodeColumn(const ColumnSource &source, size_t row, FieldWriter &writer) {
+        PythonRefHolder value(source.getObject(row));
+        encode(value.getReference(), writer);
+    }
+
+    // output of decimal fields, decimal codecs and codecs of nested fields apply options
+    virtual void setDecimalOptions(const DecimalOptions &options) {
+    }
+
+    // arrays of numeric elements are decoded to typed memoryviews instead of lists, if enabled
+    virtual void setTypedArrays(bool typed) {
+    }
+
+    // binary values are decoded to read-only memoryviews instead of bytes, if enabled
+    virtual void setBinaryViews(bool views) {
+    }
 
     const char * getFieldName() {
         return field_name_.c_str();
@@ -91,21 +163,22 @@ protected:
     };
 
 public:
-    virtual void appendRelative(T &value) {
-        if (relative_to_ != NULL && !relative_to_->isNull())
-            value = relative_to_->getValue() + value;
+    // not virtual: relative values are read from the last decoded or encoded value of base field
+    inline void appendRelative(T &value) {
+        if (relative_to_ != NULL && !relative_to_->is_null_)
+            value = relative_to_->value_ + value;
     }
 
-    virtual void substractRelative(T &value) {
-        if (relative_to_ != NULL && !relative_to_->isNull())
-            value = value - relative_to_->getValue();
+    inline void substractRelative(T &value) {
+        if (relative_to_ != NULL && !relative_to_->is_null_)
+            value = value - relative_to_->value_;
     }
 
-    virtual T & getValue() {
+    T & getValue() {
         return value_;
     }
 
-    virtual bool isNull() {
+    bool isNull() {
         return is_null_;
     }
 
@@ -116,6 +189,29 @@ protected:
     FieldValueCodec<T> *relative_to_;
 };
 
+// codec of field of unsupported encoding (e.g. size of integer), which fails only when the field is read or written
+class UnsupportedFieldCodec final : public FieldCodec {
+public:
+    UnsupportedFieldCodec(const char *field_name, const std::string &error, bool is_nullable)
+        : FieldCodec(field_name, is_nullable), error_(error) {
+    };
+
+    PyObject * decode(DxApi::DataReader &reader) {
+        THROW(error_);
+    }
+
+    void skip(DxApi::DataReader &reader) {
+        THROW(error_);
+    }
+
+    void encode(PyObject *field_value, FieldWriter &writer) {
+        THROW(error_);
+    }
+
+private:
+    std::string error_;
+};
+
 class AlphanumericFieldCodec : public FieldCodec {
 public:
     AlphanumericFieldCodec(const char* field_name, int field_size, bool is_nullable) : 
@@ -129,7 +225,22 @@ public:
             return PyUnicode_FromString(buffer_.c_str());
     }
 
-    inline void encode(PyObject *field_value, DxApi::DataWriter &writer) {
+    ColumnType getColumnType() {
+        return STRING_COLUMN;
+    }
+
+    inline void decodeColumn(DxApi::DataReader &reader, Column &column) {
+        if (reader.readAlphanumeric(buffer_, field_size_))
+            column.appendString(buffer_);
+        else
+            column.appendNull();
+    }
+
+    inline void skip(DxApi::DataReader &reader) {
+        reader.readAlphanumeric(buffer_, field_size_);
+    }
+
+    inline void encode(PyObject *field_value, FieldWriter &writer) {
         bool type_mismatch = false;
         bool exists = getStringValue(field_value, buffer_, type_mismatch);
         if (type_mismatch)
@@ -162,13 +273,46 @@ public:
             Py_RETURN_NONE;
     }
 
-    inline void encode(PyObject *field_value, DxApi::DataWriter &writer) {
-        int64_t value;
+    ColumnType getColumnType() {
+        return INT64_COLUMN;
+    }
+
+    void initColumn(Column &column) {
+        column.setArrowFormat("tsm:");
+    }
+
+    inline void decodeColumn(DxApi::DataReader &reader, Column &column) {
+        int64_t value = reader.readTimestamp();
+        if (value != DxApi::TIMESTAMP_NULL)
+            column.appendInt64(value);
+        else
+            column.appendNull();
+    }
+
+    inline void skip(DxApi::DataReader &reader) {
+        reader.readTimestamp();
+    }
+
+    inline void encode(PyObject *field_value, FieldWriter &writer) {
+        int64_t value = 0;
         bool type_mismatch;
         bool exists = getInt64Value(field_value, value, type_mismatch);
         if (type_mismatch)
             THROW_EXCEPTION("Wrong type of field '%s'. Required: INTEGER.", field_name_.c_str());
 
+        writeValue(value, exists, writer);
+    }
+
+    inline void encodeColumn(const ColumnSource &source, size_t row, FieldWriter &writer) {
+        if (!source.isNumeric())
+            return FieldCodec::encodeColumn(source, row, writer);
+
+        int64_t value = 0;
+        bool exists = source.getInt64(row, value);
+        writeValue(value, exists, writer);
+    }
+
+    inline void writeValue(int64_t value, bool exists, FieldWriter &writer) {
         if (exists) {
             if (!is_nullable_ && value == DxApi::TIMESTAMP_NULL) {
                 THROW_EXCEPTION("Field '%s' is not nullable. Value '%d' is invalid.", field_name_.c_str(), value);
@@ -185,114 +329,121 @@ public:
     }
 };
 
-class IntegerFieldCodec : public FieldValueCodec<int64_t> {
+// SIZE is a size of integer in bits (8, 16, 30, 32, 48, 61, 64), switches on it are resolved at compile time
+template <int SIZE>
+class IntegerFieldCodec final : public FieldValueCodec<int64_t> {
 public:
-    IntegerFieldCodec(const char* field_name, FieldValueCodec<int64_t> *relative_to, int field_size, bool is_nullable) 
-        : FieldValueCodec(field_name, relative_to, is_nullable), field_size_(field_size) { };
+    IntegerFieldCodec(const char* field_name, FieldValueCodec<int64_t> *relative_to, bool is_nullable) 
+        : FieldValueCodec<int64_t>(field_name, relative_to, is_nullable) { };
 
     inline PyObject * decode(DxApi::DataReader &reader) {
-        switch (field_size_) {
+        if (readValue(reader))
+            return PyLong_FromLongLong(value_);
+        else
+            Py_RETURN_NONE;
+    }
+
+    ColumnType getColumnType() {
+        return INT64_COLUMN;
+    }
+
+    inline void decodeColumn(DxApi::DataReader &reader, Column &column) {
+        if (readValue(reader))
+            column.appendInt64(value_);
+        else
+            column.appendNull();
+    }
+
+    inline void skip(DxApi::DataReader &reader) {
+        readValue(reader);
+    }
+
+    // returns false, if value is null
+    inline bool readValue(DxApi::DataReader &reader) {
+        switch (SIZE) {
         case 8: {
             int8_t result = reader.readInt8();
-            if (result != DxApi::Constants::INT8_NULL) {
-                value_ = result;
-                is_null_ = false;
-                appendRelative(value_);
-                return PyLong_FromLongLong(value_);
-            } else {
-                Py_RETURN_NONE;
-            }
+            if (result == DxApi::Constants::INT8_NULL)
+                return false;
+            value_ = result;
         }
         break;
         case 16: {
             int16_t result = reader.readInt16();
-            if (result != DxApi::Constants::INT16_NULL) {
-                value_ = result;
-                is_null_ = false;
-                appendRelative(value_);
-                return PyLong_FromLongLong(value_);
-            } else {
-                Py_RETURN_NONE;
-            }
+            if (result == DxApi::Constants::INT16_NULL)
+                return false;
+            value_ = result;
         }
         break;
         case 30: {
             uint32_t result = reader.readPUInt30();
-            if (result != DxApi::UINT30_NULL) {
-                value_ = result;
-                is_null_ = false;
-                appendRelative(value_);
-                return PyLong_FromLongLong(value_);
-            } else {
-                Py_RETURN_NONE;
-            }
+            if (result == DxApi::UINT30_NULL)
+                return false;
+            value_ = result;
         }
         break;
         case 32: {
             int32_t result = reader.readInt32();
-            if (result != DxApi::Constants::INT32_NULL) {
-                value_ = result;
-                is_null_ = false;
-                appendRelative(value_);
-                return PyLong_FromLongLong(value_);
-            } else {
-                Py_RETURN_NONE;
-            }
+            if (result == DxApi::Constants::INT32_NULL)
+                return false;
+            value_ = result;
         }
         break;
         case 48: {
             int64_t result = reader.readInt48();
-            if (result != DxApi::INT48_NULL) {
-                value_ = result;
-                is_null_ = false;
-                appendRelative(value_);
-                return PyLong_FromLongLong(value_);
-            } else {
-                Py_RETURN_NONE;
-            }
+            if (result == DxApi::INT48_NULL)
+                return false;
+            value_ = result;
         }
         break;
         case 61: {
             uint64_t result = reader.readPUInt61();
-            if (result != DxApi::UINT61_NULL) {
-                value_ = result;
-                is_null_ = false;
-                appendRelative(value_);
-                return PyLong_FromLongLong(value_);
-            } else {
-                Py_RETURN_NONE;
-            }
+            if (result == DxApi::UINT61_NULL)
+                return false;
+            value_ = result;
         }
         break;
         case 64: {
             int64_t result = reader.readInt64();
-            if (result != DxApi::INT64_NULL) {
-                value_ = result;
-                is_null_ = false;
-                appendRelative(value_);
-                return PyLong_FromLongLong(value_);
-            } else {
-                Py_RETURN_NONE;
-            }
+            if (result == DxApi::INT64_NULL)
+                return false;
+            value_ = result;
         }
         break;
         default:
-            THROW_EXCEPTION("Unknow size of integer: %d.", field_size_);
+            THROW_EXCEPTION("Unknow size of integer: %d.", SIZE);
         }
+
+        is_null_ = false;
+        appendRelative(value_);
+        return true;
     }
 
-    inline void encode(PyObject *field_value, DxApi::DataWriter &writer) {
+    inline void encode(PyObject *field_value, FieldWriter &writer) {
         bool type_mismatch;
         bool exists = getInt64Value(field_value, value_, type_mismatch);
         if (type_mismatch)
             THROW_EXCEPTION("Wrong type of field '%s'. Required: INTEGER.", field_name_.c_str());
+
+        writeValue(exists, writer);
+    }
+
+    inline void encodeColumn(const ColumnSource &source, size_t row, FieldWriter &writer) {
+        if (!source.isNumeric())
+            return FieldCodec::encodeColumn(source, row, writer);
+
+        writeValue(source.getInt64(row, value_), writer);
+    }
+
+    // writes value_ or null, if value doesn't exist
+    inline void writeValue(bool exists, FieldWriter &writer) {
         if (!exists) {
             if (!is_nullable_) {
                 THROW_EXCEPTION("Field '%s' is not nullable.", field_name_.c_str());
             }
 
             is_null_ = true;
-            switch (field_size_) {
+            switch (SIZE) {
             case 8: {
                 writer.writeInt8(DxApi::Constants::INT8_NULL);
             }
@@ -322,12 +473,12 @@ public:
             }
             break;
             default:
-                THROW_EXCEPTION("Unknow size of integer: %d.", field_size_);
+                THROW_EXCEPTION("Unknow size of integer: %d.", SIZE);
             }
         } else {
             substractRelative(value_);
             is_null_ = false;
-            switch (field_size_)
+            switch (SIZE)
             {
             case 8: {
                 int8_t writeValue = (int8_t)value_;
@@ -391,38 +542,121 @@ public:
             }
             break;
             default:
-                THROW_EXCEPTION("Unknow size of integer: %d.", field_size_);
+                THROW_EXCEPTION("Unknow size of integer: %d.", SIZE);
             }
         }
        
     }
-
-private:
-    int field_size_;
 };
 
 class Decimal64FieldCodec : public FieldCodec {
-    static const int64_t DECIMAL64_NULL = 0xFFFFFFFFFFFFFF80LL; // = -0x80L;
+    // decimal objects are immutable, so objects of recent values are shared
+    static const size_t DECIMAL_OBJECTS_CACHE_SIZE = 256;
 
 public:
     Decimal64FieldCodec(const char* field_name, bool is_nullable) : FieldCodec(field_name, is_nullable) { };
 
+    ~Decimal64FieldCodec() {
+        for (PyObject *object : cached_objects_)
+            Py_XDECREF(object);
+        Py_XDECREF(decimal_class_);
+    }
+
     inline PyObject * decode(DxApi::DataReader &reader) {
         int64_t result = reader.readInt64();
-        if (result != DECIMAL64_NULL) {
-            return PyFloat_FromDouble(decodeDecimal64(result));
-        } else {
+        if (result == DECIMAL64_NULL)
             Py_RETURN_NONE;
+
+        switch (mode_) {
+        case DECIMAL_RAW:
+            return PyLong_FromLongLong(result);
+        case DECIMAL_FIXED: {
+            int64_t fixed;
+            if (!toFixed(result, fixed))
+                Py_RETURN_NONE;
+            return PyLong_FromLongLong(fixed);
+        }
+        case DECIMAL_OBJECT:
+            return getDecimalObject(result);
+        default:
+            return PyFloat_FromDouble(decodeDecimal64(result));
+        }
+    }
+
+    ColumnType getColumnType() {
+        switch (mode_) {
+        case DECIMAL_RAW:
+        case DECIMAL_FIXED:
+            return INT64_COLUMN;
+        case DECIMAL_OBJECT:
+            return OBJECT_COLUMN;
+        default:
+            return FLOAT64_COLUMN;
         }
     }
+
+    // values are encoded from floats in all decimal modes
+    ColumnType getEncodeColumnType() {
+        return FLOAT64_COLUMN;
+    }
+
+    inline void decodeColumn(DxApi::DataReader &reader, Column &column) {
+        int64_t result = reader.readInt64();
+        if (result == DECIMAL64_NULL) {
+            column.appendNull();
+            return;
+        }
+
+        switch (mode_) {
+        case DECIMAL_RAW:
+            column.appendInt64(result);
+            break;
+        case DECIMAL_FIXED: {
+            int64_t fixed;
+            if (toFixed(result, fixed))
+                column.appendInt64(fixed);
+            else
+                column.appendNull();
+            break;
+        }
+        case DECIMAL_OBJECT:
+            column.appendObject(getDecimalObject(result));
+            break;
+        default:
+            column.appendDecimal64(result);
+            break;
+        }
+    }
+
+    void setDecimalOptions(const DecimalOptions &options) {
+        mode_ = options.mode;
+        scale_ = options.getScale(field_name_);
+    }
+
+    inline void skip(DxApi::DataReader &reader) {
+        reader.readInt64();
+    }
     
-    inline void encode(PyObject *field_value, DxApi::DataWriter &writer) {
-        double value;
+    inline void encode(PyObject *field_value, FieldWriter &writer) {
+        double value = 0;
         bool type_mismatch;
         bool exists = getDoubleValue(field_value, value, type_mismatch);
         if (type_mismatch)
             THROW_EXCEPTION("Wrong type of field '%s'. Required: DOUBLE.", field_name_.c_str());
 
+        writeValue(value, exists, writer);
+    }
+
+    inline void encodeColumn(const ColumnSource &source, size_t row, FieldWriter &writer) {
+        if (!source.isNumeric())
+            return FieldCodec::encodeColumn(source, row, writer);
+
+        double value = 0;
+        bool exists = source.getFloat64(row, value);
+        writeValue(value, exists, writer);
+    }
+
+    inline void writeValue(double value, bool exists, FieldWriter &writer) {
         if (exists) {
             writer.writeInt64(encodeDecimal64(value));
         } else {
@@ -434,78 +668,163 @@ public:
         }
     }
 
-    inline double decodeDecimal64(int64_t value) {
-        return dfp_toDouble(value);
+private:
+    // infinities and NaNs have no fixed-point value
+    inline bool toFixed(int64_t value, int64_t &result) {
+        if (!isDecimal64Finite(value))
+            return false;
+
+        if (!decimal64ToFixed(value, scale_, result))
+            THROW_EXCEPTION("Value of field '%s' doesn't fit 64-bit integer with scale %d.", field_name_.c_str(), scale_);
+        return true;
     }
 
-    inline int64_t encodeDecimal64(double value) {
-        return dfp_fromDouble(value);
+    // returns new reference
+    PyObject * getDecimalObject(int64_t value) {
+        if (cached_objects_.empty()) {
+            cached_values_.assign(DECIMAL_OBJECTS_CACHE_SIZE, DECIMAL64_NULL);
+            cached_objects_.assign(DECIMAL_OBJECTS_CACHE_SIZE, NULL);
+        }
+
+        size_t index = (size_t) (((uint64_t) value * 0x9E3779B97F4A7C15ULL) >> 56);
+        if (cached_objects_[index] == NULL || cached_values_[index] != value) {
+            PyObject *object = newDecimalObject(value);
+            Py_XDECREF(cached_objects_[index]);
+            cached_objects_[index] = object;
+            cached_values_[index] = value;
+        }
+
+        Py_INCREF(cached_objects_[index]);
+        return cached_objects_[index];
     }
+
+    PyObject * newDecimalObject(int64_t value) {
+        if (decimal_class_ == NULL) {
+            PythonRefHolder module(PyImport_ImportModule("decimal"));
+            if (module.getReference() == NULL)
+                THROW("Module 'decimal' is not loaded.");
+
+            decimal_class_ = PyObject_GetAttrString(module.getReference(), "Decimal");
+            if (decimal_class_ == NULL)
+                THROW("Class 'Decimal' not found in module 'decimal'.");
+        }
+
+        // text of coefficient and exponent is converted to decimal without rounding
+        char text[32];
+        if (isDecimal64Infinity(value)) {
+            snprintf(text, sizeof(text), "%sInfinity", value < 0 ? "-" : "");
+        } else if (!isDecimal64Finite(value)) {
+            snprintf(text, sizeof(text), "NaN");
+        } else {
+            bool negative;
+            uint64_t coefficient;
+            int32_t exponent;
+            unpackDecimal64(value, negative, coefficient, exponent);
+            snprintf(text, sizeof(text), "%s%lluE%d", negative ? "-" : "", (unsigned long long) coefficient, (int) exponent);
+        }
+
+        PyObject *object = PyObject_CallFunction(decimal_class_, "s", text);
+        if (object == NULL)
+            THROW_EXCEPTION("Can't create decimal of field '%s'.", field_name_.c_str());
+        return object;
+    }
+
+    DecimalMode mode_ = DECIMAL_FLOAT;
+    int32_t scale_ = 0;
+
+    PyObject *decimal_class_ = NULL;
+    std::vector<int64_t> cached_values_;
+    std::vector<PyObject *> cached_objects_;
 };
 
-class FloatFieldCodec : public FieldValueCodec<double> {
+// SIZE is 32 (ieee32), 63 (decimal) or 64 (ieee64)
+template <int SIZE>
+class FloatFieldCodec final : public FieldValueCodec<double> {
 public:
-    FloatFieldCodec(const char* field_name, FieldValueCodec *relative_to, int field_size, bool is_nullable) 
-        : FieldValueCodec(field_name, relative_to, is_nullable), field_size_(field_size) {
+    FloatFieldCodec(const char* field_name, FieldValueCodec<double> *relative_to, bool is_nullable) 
+        : FieldValueCodec<double>(field_name, relative_to, is_nullable) {
     };
     
     inline PyObject * decode(DxApi::DataReader &reader) {
-        switch (field_size_) {
+        if (readValue(reader))
+            return PyFloat_FromDouble(value_);
+        else
+            Py_RETURN_NONE;
+    }
+
+    ColumnType getColumnType() {
+        return FLOAT64_COLUMN;
+    }
+
+    inline void decodeColumn(DxApi::DataReader &reader, Column &column) {
+        if (readValue(reader))
+            column.appendFloat64(value_);
+        else
+            column.appendNull();
+    }
+
+    inline void skip(DxApi::DataReader &reader) {
+        readValue(reader);
+    }
+
+    // returns false, if value is null
+    inline bool readValue(DxApi::DataReader &reader) {
+        switch (SIZE) {
         case 32: {
             float result = reader.readFloat32();
-            if (result != result) {
-                Py_RETURN_NONE;
-            } else {
-                value_ = result;
-                is_null_ = false;
-                appendRelative(value_);
-                return PyFloat_FromDouble(value_);
-            }
+            if (result != result)
+                return false;
+            value_ = result;
         }
         break;
         case 63: {
             double result = reader.readDecimal();
             value_ = result;
-            if (result != result) {
-                Py_RETURN_NONE;
-            } else {
-                value_ = result;
-                is_null_ = false;
-                appendRelative(value_);
-                return PyFloat_FromDouble(value_);
-            }
+            if (result != result)
+                return false;
         }
         break;
         case 64: {
             double result = reader.readFloat64();
             value_ = result;
-            if (result != result) {
-                Py_RETURN_NONE;
-            } else {
-                value_ = result;
-                is_null_ = false;
-                appendRelative(value_);
-                return PyFloat_FromDouble(value_);
-            }
+            if (result != result)
+                return false;
         }
         break;
         default:
-            THROW_EXCEPTION("Unknow size of float: %d.", field_size_);
+            THROW_EXCEPTION("Unknow size of float: %d.", SIZE);
         }
+
+        is_null_ = false;
+        appendRelative(value_);
+        return true;
     }
 
-    inline void encode(PyObject *field_value, DxApi::DataWriter &writer) {
+    inline void encode(PyObject *field_value, FieldWriter &writer) {
         bool type_mismatch;
         bool exists = getDoubleValue(field_value, value_, type_mismatch);
         if (type_mismatch)
             THROW_EXCEPTION("Wrong type of field '%s'. Required: FLOAT.", field_name_.c_str());
+
+        writeValue(exists, writer);
+    }
+
+    inline void encodeColumn(const ColumnSource &source, size_t row, FieldWriter &writer) {
+        if (!source.isNumeric())
+            return FieldCodec::encodeColumn(source, row, writer);
+
+        writeValue(source.getFloat64(row, value_), writer);
+    }
+
+    // writes value_ or null, if value doesn't exist
+    inline void writeValue(bool exists, FieldWriter &writer) {
         if (!exists) {
             if (!is_nullable_) {
                 THROW_EXCEPTION("Field '%s' is not nullable.", field_name_.c_str());
             }
 
             is_null_ = true;
-            switch (field_size_) {
+            switch (SIZE) {
             case 32: {
                 writer.writeFloat32(DxApi::FLOAT32_NULL);
             }
@@ -519,12 +838,12 @@ public:
             }
             break;
             default:
-                THROW_EXCEPTION("Unknow size of float: %d.", field_size_);
+                THROW_EXCEPTION("Unknow size of float: %d.", SIZE);
             }
         } else {
             substractRelative(value_);
             is_null_ = false;
-            switch (field_size_)
+            switch (SIZE)
             {
             case 32: {
                 writer.writeFloat32((float)value_);
@@ -539,13 +858,10 @@ public:
             }
             break;
             default:
-                THROW_EXCEPTION("Unknow size of float: %d.", field_size_);
+                THROW_EXCEPTION("Unknow size of float: %d.", SIZE);
             }
         }
     }
-
-protected:
-    int field_size_;
 };
 
 class IntervalFieldCodec : public FieldCodec {
@@ -560,12 +876,42 @@ public:
             Py_RETURN_NONE;
     }
 
-    inline void encode(PyObject *field_value, DxApi::DataWriter &writer) {
-        int32_t value;
+    ColumnType getColumnType() {
+        return INT64_COLUMN;
+    }
+
+    inline void decodeColumn(DxApi::DataReader &reader, Column &column) {
+        int32_t result = reader.readInterval();
+        if (result != DxApi::Constants::INTERVAL_NULL)
+            column.appendInt64(result);
+        else
+            column.appendNull();
+    }
+
+    inline void skip(DxApi::DataReader &reader) {
+        reader.readInterval();
+    }
+
+    inline void encode(PyObject *field_value, FieldWriter &writer) {
+        int32_t value = 0;
         bool type_mismatch;
         bool exists = getInt32Value(field_value, value, type_mismatch);
         if (type_mismatch)
             THROW_EXCEPTION("Wrong type of field '%s'. Required: INTEGER.", field_name_.c_str());
+
+        writeValue(value, exists, writer);
+    }
+
+    inline void encodeColumn(const ColumnSource &source, size_t row, FieldWriter &writer) {
+        if (!source.isNumeric())
+            return FieldCodec::encodeColumn(source, row, writer);
+
+        int64_t value = 0;
+        bool exists = source.getInt64(row, value);
+        writeValue((int32_t) value, exists, writer);
+    }
+
+    inline void writeValue(int32_t value, bool exists, FieldWriter &writer) {
         if (exists) {
             if (!is_nullable_ && value == DxApi::Constants::INTERVAL_NULL) {
                 THROW_EXCEPTION("Field '%s' is not nullable. Value '%d' is invalid.", field_name_.c_str(), value);
@@ -595,12 +941,42 @@ public:
         }
     }
 
-    inline void encode(PyObject *field_value, DxApi::DataWriter &writer) {
-        int32_t value;
+    ColumnType getColumnType() {
+        return INT64_COLUMN;
+    }
+
+    inline void decodeColumn(DxApi::DataReader &reader, Column &column) {
+        int32_t result = reader.readTimeOfDay();
+        if (result != DxApi::Constants::TIMEOFDAY_NULL)
+            column.appendInt64(result);
+        else
+            column.appendNull();
+    }
+
+    inline void skip(DxApi::DataReader &reader) {
+        reader.readTimeOfDay();
+    }
+
+    inline void encode(PyObject *field_value, FieldWriter &writer) {
+        int32_t value = 0;
         bool type_mismatch;
         bool exists = getInt32Value(field_value, value, type_mismatch);
         if (type_mismatch)
             THROW_EXCEPTION("Wrong type of field '%s'. Required: INTEGER.", field_name_.c_str());
+
+        writeValue(value, exists, writer);
+    }
+
+    inline void encodeColumn(const ColumnSource &source, size_t row, FieldWriter &writer) {
+        if (!source.isNumeric())
+            return FieldCodec::encodeColumn(source, row, writer);
+
+        int64_t value = 0;
+        bool exists = source.getInt64(row, value);
+        writeValue((int32_t) value, exists, writer);
+    }
+
+    inline void writeValue(int32_t value, bool exists, FieldWriter &writer) {
         if (exists) {
             if (!is_nullable_ && value == DxApi::Constants::TIMEOFDAY_NULL) {
                 THROW_EXCEPTION("Field '%s' is not nullable. Value '%d' is invalid.", field_name_.c_str(), value);
@@ -622,6 +998,9 @@ public:
     BinaryFieldCodec(const char* field_name, bool is_nullable) : FieldCodec(field_name, is_nullable) {};
 
     inline PyObject * decode(DxApi::DataReader &reader) {
+        if (binary_views_)
+            return decodeView(reader);
+
         bool not_null = reader.readBinary(buffer_);
         if (not_null) {
             return PyBytes_FromStringAndSize(reinterpret_cast<char*>(buffer_.data()), buffer_.size());
@@ -631,7 +1010,15 @@ public:
         }
     }
 
-    inline void encode(PyObject *field_value, DxApi::DataWriter &writer) {
+    inline void skip(DxApi::DataReader &reader) {
+        reader.readBinary(buffer_);
+    }
+
+    void setBinaryViews(bool views) {
+        binary_views_ = views;
+    }
+
+    inline void encode(PyObject *field_value, FieldWriter &writer) {
         if (field_value == Py_None || field_value == NULL) {
             if (!is_nullable_) {
                 THROW_EXCEPTION("Field '%s' is not nullable.", field_name_.c_str());
@@ -665,13 +1052,34 @@ public:
                 writer.writeBinaryArray(bytes, PyByteArray_Size(field_value));
             }
         }
+        else if (PyObject_CheckBuffer(field_value)) {
+            // memoryviews, numpy arrays, mmaps: contiguous bytes are written in place
+            PythonBufferHolder buffer(field_value, PyBUF_SIMPLE);
+            if (!buffer.isAcquired()) {
+                PyErr_Clear();
+                THROW_EXCEPTION("Wrong type of '%s' field. Required: contiguous buffer.", field_name_.c_str());
+            }
+
+            writer.writeBinaryArray((const uint8_t *) buffer.getBuffer().buf, (size_t) buffer.getBuffer().len);
+        }
         else {
             THROW_EXCEPTION("Wrong type of '%s' field. Required: BYTES.", field_name_.c_str());
         }
     }
 
 private:
+    // returns read-only memoryview over new buffer, which value is copied into (bytes object is not created)
+    PyObject * decodeView(DxApi::DataReader &reader) {
+        PythonRefHolder view_buffer(newBinaryBuffer());
+        if (!reader.readBinary(getBinaryBufferData(view_buffer.getReference())))
+            Py_RETURN_NONE;
+
+        return PyMemoryView_FromObject(view_buffer.getReference());
+    }
+
     std::vector<uint8_t> buffer_;
+
+    bool binary_views_ = false;
 };
 
 class BooleanFieldCodec : public FieldCodec {
@@ -696,11 +1104,49 @@ public:
         }
     }
 
-    inline void encode(PyObject *field_value, DxApi::DataWriter &writer) {
-        bool ret_value;
+    ColumnType getColumnType() {
+        return BOOLEAN_COLUMN;
+    }
+
+    inline void decodeColumn(DxApi::DataReader &reader, Column &column) {
+        if (is_nullable_) {
+            uint8_t result = reader.readNullableBooleanInt8();
+            if (result == DxApi::Constants::BOOL_TRUE)
+                column.appendBoolean(true);
+            else if (result == DxApi::Constants::BOOL_FALSE)
+                column.appendBoolean(false);
+            else
+                column.appendNull();
+        } else {
+            column.appendBoolean(reader.readBoolean());
+        }
+    }
+
+    inline void skip(DxApi::DataReader &reader) {
+        if (is_nullable_)
+            reader.readNullableBooleanInt8();
+        else
+            reader.readBoolean();
+    }
+
+    inline void encode(PyObject *field_value, FieldWriter &writer) {
+        bool ret_value = false;
         bool exists = getBooleanValue(field_value, ret_value);
+        writeValue(ret_value, exists, writer);
+    }
+
+    inline void encodeColumn(const ColumnSource &source, size_t row, FieldWriter &writer) {
+        if (!source.isNumeric())
+            return FieldCodec::encodeColumn(source, row, writer);
+
+        int64_t value = 0;
+        bool exists = source.getInt64(row, value);
+        writeValue(value != 0, exists, writer);
+    }
+
+    inline void writeValue(bool value, bool exists, FieldWriter &writer) {
         if (exists) {
-            writer.writeBoolean(ret_value);
+            writer.writeBoolean(value);
         } else {
             if (!is_nullable_) {
                 THROW_EXCEPTION("Field '%s' is not nullable.", field_name_.c_str());
@@ -727,30 +1173,22 @@ public:
         }
     }
 
-    inline void encode(PyObject *field_value, DxApi::DataWriter &writer) {
+    inline void skip(DxApi::DataReader &reader) {
+        reader.readWChar();
+    }
+
+    inline void encode(PyObject *field_value, FieldWriter &writer) {
         if (field_value == NULL || Py_None == field_value) {
             writer.writeWChar(DxApi::Constants::CHAR_NULL);
         } else {
             if (PyUnicode_Check(field_value)) {
-                std::wstring str;
-                str.resize(PyUnicode_GetSize(field_value) + 1, 0);
-                int len = (int)PyUnicode_AsWideChar(
-#if PY_VERSION_HEX < 0x03020000
-                    (PyUnicodeObject *)
-#endif
-                    field_value, &str[0], (Py_ssize_t)str.size());
-                if (len > -1)
-                {
-                    assert(len < (int)str.size());
-                    str[len] = 0;
-                }
-                else str[str.size() - 1] = 0;
-
-                if (!is_nullable_ && str[0] == DxApi::Constants::CHAR_NULL) {
-                    THROW_EXCEPTION("Field '%s' is not nullable. Value '%d' is invalid.", field_name_.c_str(), str[0]);
+                // reads first character in place, without conversion of string
+                wchar_t ch = PyUnicode_GET_LENGTH(field_value) > 0 ? (wchar_t) PyUnicode_READ_CHAR(field_value, 0) : 0;
+                if (!is_nullable_ && ch == DxApi::Constants::CHAR_NULL) {
+                    THROW_EXCEPTION("Field '%s' is not nullable. Value '%d' is invalid.", field_name_.c_str(), ch);
                 }
 
-                writer.writeWChar(str[0]);
+                writer.writeWChar(ch);
             } else {
                 if (!is_nullable_) {
                     THROW_EXCEPTION("Field '%s' is not nullable.", field_name_.c_str());
@@ -775,37 +1213,37 @@ public:
         }
     }
 
-    inline void encode(PyObject *field_value, DxApi::DataWriter &writer) {
-        if (Py_None == field_value || field_value == NULL) {
+    ColumnType getColumnType() {
+        return STRING_COLUMN;
+    }
+
+    inline void decodeColumn(DxApi::DataReader &reader, Column &column) {
+        if (reader.readUTF8(buffer))
+            column.appendString(buffer);
+        else
+            column.appendNull();
+    }
+
+    inline void skip(DxApi::DataReader &reader) {
+        reader.readUTF8(buffer);
+    }
+
+    inline void encode(PyObject *field_value, FieldWriter &writer) {
+        // utf-8 buffer of string is written directly, without intermediate copies
+        const char *str;
+        Py_ssize_t size;
+        bool type_mismatch;
+        bool exists = getStringBuffer(field_value, str, size, type_mismatch);
+        if (type_mismatch)
+            THROW_EXCEPTION("Wrong type of field '%s'. Required: STRING.", field_name_.c_str());
+        if (exists) {
+            writer.writeUTF8(str, (size_t) size);
+        } else {
             if (!is_nullable_) {
                 THROW_EXCEPTION("Field '%s' is not nullable.", field_name_.c_str());
             }
 
             writer.writeUTF8((const std::string *) NULL);
-        } else {
-            if (PyUnicode_Check(field_value)) {
-                std::wstring str;
-                str.resize(PyUnicode_GetSize(field_value) + 1, 0);
-                int len = (int)PyUnicode_AsWideChar(
-#if PY_VERSION_HEX < 0x03020000
-                    (PyUnicodeObject *)
-#endif
-                    field_value, &str[0], (Py_ssize_t)str.size());
-                if (len > -1) {
-                    assert(len < (int)str.size());
-                } else {
-                    len = str.size() - 1;
-                }
-                str[len] = 0;
-
-                writer.writeUTF8(str.c_str(), len);
-            } else {
-                if (!is_nullable_) {
-                    THROW_EXCEPTION("Field '%s' is not nullable.", field_name_.c_str());
-                }
-
-                writer.writeUTF8((const std::string *) NULL);
-            }
         }
     }
 
@@ -827,39 +1265,42 @@ public:
         }
     }
 
-    inline void encode(PyObject *field_value, DxApi::DataWriter &writer) {
-        if (Py_None == field_value || field_value == NULL) {
-            if (!is_nullable_) {
-                THROW_EXCEPTION("Field '%s' is not nullable.", field_name_.c_str());
-            }
+    ColumnType getColumnType() {
+        return STRING_COLUMN;
+    }
 
-            writer.writeAscii((const std::string *)NULL);
-        }
-        else {
-            if (PyUnicode_Check(field_value)) {
-                std::wstring str;
-                str.resize(PyUnicode_GetSize(field_value) + 1, 0);
-                int len = (int)PyUnicode_AsWideChar(
-#if PY_VERSION_HEX < 0x03020000
-                    (PyUnicodeObject *)
-#endif
-                    field_value, &str[0], (Py_ssize_t)str.size());
-                if (len > -1) {
-                    assert(len < (int)str.size());
-                } else {
-                    len = str.size() - 1;
-                }
-                str[len] = 0;
+    inline void decodeColumn(DxApi::DataReader &reader, Column &column) {
+        if (reader.readAscii(buffer))
+            column.appendString(buffer);
+        else
+            column.appendNull();
+    }
 
-                writer.writeAscii(str.c_str(), len);
-            }
-            else {
-                if (!is_nullable_) {
-                    THROW_EXCEPTION("Field '%s' is not nullable.", field_name_.c_str());
-                }
+    inline void skip(DxApi::DataReader &reader) {
+        reader.readAscii(buffer);
+    }
 
-                writer.writeAscii((const std::string *)NULL);
+    inline void encode(PyObject *field_value, FieldWriter &writer) {
+        // utf-8 buffer of string is written directly, without intermediate copies
+        const char *str;
+        Py_ssize_t size;
+        bool type_mismatch;
+        bool exists = getStringBuffer(field_value, str, size, type_mismatch);
+#if PY_MAJOR_VERSION >= 3
+        // utf-8 buffer is the ascii encoding only for ascii strings
+        if (exists && !PyUnicode_IS_ASCII(field_value))
+            type_mismatch = true;
+#endif
+        if (type_mismatch)
+            THROW_EXCEPTION("Wrong type of field '%s'. Required: ASCII STRING.", field_name_.c_str());
+        if (exists) {
+            writer.writeAscii(str, (size_t) size);
+        } else {
+            if (!is_nullable_) {
+                THROW_EXCEPTION("Field '%s' is not nullable.", field_name_.c_str());
             }
+
+            writer.writeAscii((const std::string *) NULL);
         }
     }
 
@@ -867,69 +1308,72 @@ private:
     std::string buffer;
 };
 
-class EnumFieldCodec : public FieldCodec {
+// SIZE is a size of enum value in bits (8, 16, 32, 64)
+template <int SIZE>
+class EnumFieldCodec final : public FieldCodec {
 public:
     EnumFieldCodec(const char* field_name, const Schema::TickDbClassDescriptor &descriptor, bool is_nullable) 
         : FieldCodec(field_name, is_nullable), descriptor_(descriptor) {
     };
 
     inline PyObject * decode(DxApi::DataReader &reader) {
-        switch (descriptor_.enumType) {
-        case Schema::FieldTypeEnum::ENUM8: {
-            int8_t result = reader.readEnum8();
-            if (result != DxApi::Constants::ENUM_NULL) {
-                if (result < 0 || result >= descriptor_.enumSymbols.size())
-                    THROW_EXCEPTION("Enum value out of bound for '%s' field.", field_name_.c_str());
-
-                return PyUnicode_FromString(descriptor_.enumSymbols[result].c_str());
-            } else {
-                Py_RETURN_NONE;
-            }
-        }
-        break;
-        case Schema::FieldTypeEnum::ENUM16: {
-            int16_t result = reader.readEnum16();
-
-            if (result != DxApi::ENUM_NULL) {
-                if (result < 0 || result >= descriptor_.enumSymbols.size())
-                    THROW_EXCEPTION("Enum value out of bound for '%s' field.", field_name_.c_str());
+        int64_t result = readValue(reader);
+        if (result != DxApi::Constants::ENUM_NULL)
+            return PyUnicode_FromString(descriptor_.enumSymbols[result].c_str());
+        else
+            Py_RETURN_NONE;
+    }
 
-                return PyUnicode_FromString(descriptor_.enumSymbols[result].c_str());
-            } else {
-                Py_RETURN_NONE;
-            }
-        }
-        break;
-        case Schema::FieldTypeEnum::ENUM32: {
-            int32_t result = reader.readEnum32();
+    ColumnType getColumnType() {
+        return CATEGORY_COLUMN;
+    }
 
-            if (result != DxApi::Constants::ENUM_NULL) {
-                if (result < 0 || result >= descriptor_.enumSymbols.size())
-                    THROW_EXCEPTION("Enum value out of bound for '%s' field.", field_name_.c_str());
+    void initColumn(Column &column) {
+        column.setCategories(descriptor_.enumSymbols);
+    }
 
-                return PyUnicode_FromString(descriptor_.enumSymbols[result].c_str());
-            } else {
-                Py_RETURN_NONE;
-            }
-        }
-        case Schema::FieldTypeEnum::ENUM64: {
-            int64_t result = reader.readEnum64();
+    inline void decodeColumn(DxApi::DataReader &reader, Column &column) {
+        int64_t result = readValue(reader);
+        if (result != DxApi::Constants::ENUM_NULL)
+            column.appendCategory(result);
+        else
+            column.appendNull();
+    }
 
-            if (result != DxApi::Constants::ENUM_NULL) {
-                if (result < 0 || result >= (int64_t) descriptor_.enumSymbols.size())
-                    THROW_EXCEPTION("Enum value out of bound for '%s' field.", field_name_.c_str());
+    inline void skip(DxApi::DataReader &reader) {
+        readValue(reader);
+    }
 
-                return PyUnicode_FromString(descriptor_.enumSymbols[result].c_str());
-            } else {
-                Py_RETURN_NONE;
-            }
-        }
+    // returns index of enum symbol or ENUM_NULL
+    inline int64_t readValue(DxApi::DataReader &reader) {
+        int64_t result;
+        switch (SIZE) {
+        case 8:
+            result = reader.readEnum8();
+            break;
+        case 16:
+            result = reader.readEnum16();
+            break;
+        case 32:
+            result = reader.readEnum32();
+            break;
+        case 64:
+            result = reader.readEnum64();
+            break;
         default:
             THROW_EXCEPTION("Unknow type of enum for '%s' field.", field_name_.c_str());
         }
+
+        if (result == DxApi::Constants::ENUM_NULL)
+            return result;
+
+        if (result < 0 || result >= (int64_t) descriptor_.enumSymbols.size())
+            THROW_EXCEPTION("Enum value out of bound for '%s' field.", field_name_.c_str());
+
+        return result;
     }
 
-    inline void encode(PyObject *field_value, DxApi::DataWriter &writer) {
+    inline void encode(PyObject *field_value, FieldWriter &writer) {
         bool type_mismatch;
         bool exists = getStringValue(field_value, buffer_, type_mismatch);
         if (type_mismatch)
@@ -940,17 +1384,17 @@ public:
             if (it == descriptor_.symbolToEnumValue.end())
                 THROW_EXCEPTION("Unknown enum value '%s' of field '%s'", buffer_.c_str(), field_name_.c_str());
 
-            switch (descriptor_.enumType) {
-            case Schema::FieldTypeEnum::ENUM8:
+            switch (SIZE) {
+            case 8:
                 writer.writeEnum8(descriptor_.symbolToEnumValue[buffer_]);
                 break;
-            case Schema::FieldTypeEnum::ENUM16:
+            case 16:
                 writer.writeEnum16(descriptor_.symbolToEnumValue[buffer_]);
                 break;
-            case Schema::FieldTypeEnum::ENUM32:
+            case 32:
                 writer.writeEnum32(descriptor_.symbolToEnumValue[buffer_]);
                 break;
-            case Schema::FieldTypeEnum::ENUM64:
+            case 64:
                 writer.writeEnum64(descriptor_.symbolToEnumValue[buffer_]);
                 break;
             default:
@@ -961,17 +1405,17 @@ public:
                 THROW_EXCEPTION("Field '%s' is not nullable.", field_name_.c_str());
             }
 
-            switch (descriptor_.enumType) {
-            case Schema::FieldTypeEnum::ENUM8:
+            switch (SIZE) {
+            case 8:
                 writer.writeEnum8(DxApi::Constants::ENUM_NULL);
                 break;
-            case Schema::FieldTypeEnum::ENUM16:
+            case 16:
                 writer.writeEnum16(DxApi::Constants::ENUM_NULL);
                 break;
-            case Schema::FieldTypeEnum::ENUM32:
+            case 32:
                 writer.writeEnum32(DxApi::Constants::ENUM_NULL);
                 break;
-            case Schema::FieldTypeEnum::ENUM64:
+            case 64:
                 writer.writeEnum64(DxApi::Constants::ENUM_NULL);
                 break;
             default:
@@ -996,6 +1440,9 @@ public:
         if (len == DxApi::Constants::INT32_NULL)
             Py_RETURN_NONE;
 
+        if (elements_ != nullptr)
+            return decodeTyped(reader, len);
+
         PyObject *list = PyList_New(len);
         for (int i = 0; i < len; ++i) {
             PyObject *element = element_codec_->decode(reader);
@@ -1006,7 +1453,69 @@ public:
         return list;
     }
 
-    inline void encode(PyObject *field_value, DxApi::DataWriter &writer) {
+    // arrays of elements, which are decoded to native columns, are decoded to list columns
+    ColumnType getColumnType() {
+        return element_codec_->getColumnType() != OBJECT_COLUMN ? LIST_COLUMN : OBJECT_COLUMN;
+    }
+
+    void initColumn(Column &column) {
+        if (column.getType() == LIST_COLUMN)
+            element_codec_->initColumn(column.setElements(element_codec_->getColumnType()));
+    }
+
+    inline void decodeColumn(DxApi::DataReader &reader, Column &column) {
+        if (column.getType() != LIST_COLUMN)
+            return FieldCodec::decodeColumn(reader, column);
+
+        int32_t len = reader.readArrayStart();
+        if (len == DxApi::Constants::INT32_NULL) {
+            column.appendNull();
+            return;
+        }
+
+        Column &elements = *column.getElements();
+        for (int i = 0; i < len; ++i)
+            element_codec_->decodeColumn(reader, elements);
+        reader.readArrayEnd();
+
+        column.setTypedLists(typed_arrays_);
+        column.endList();
+    }
+
+    inline void skip(DxApi::DataReader &reader) {
+        int32_t len = reader.readArrayStart();
+        if (len == DxApi::Constants::INT32_NULL)
+            return;
+
+        for (int i = 0; i < len; ++i)
+            element_codec_->skip(reader);
+        reader.readArrayEnd();
+    }
+
+    void setDecimalOptions(const DecimalOptions &options) {
+        element_codec_->setDecimalOptions(options);
+
+        // type of elements depends on decimal mode
+        setTypedArrays(typed_arrays_);
+    }
+
+    void setBinaryViews(bool views) {
+        element_codec_->setBinaryViews(views);
+    }
+
+    void setTypedArrays(bool typed) {
+        typed_arrays_ = typed;
+        element_codec_->setTypedArrays(typed);
+
+        ColumnType type = element_codec_->getColumnType();
+        bool numeric = type == INT64_COLUMN || type == FLOAT64_COLUMN || type == BOOLEAN_COLUMN;
+        if (typed && numeric)
+            elements_.reset(new Column(field_name_, type));
+        else
+            elements_.reset();
+    }
+
+    inline void encode(PyObject *field_value, FieldWriter &writer) {
         if (field_value == NULL) {
             if (!is_nullable_) {
                 THROW_EXCEPTION("Field '%s' is not nullable.", field_name_.c_str());
@@ -1024,21 +1533,72 @@ public:
                 element_codec_->encode(PyList_GetItem(field_value, i), writer);
             }
             writer.writeArrayEnd();
-        } else {
-            if (field_value == Py_None) {
-                if (!is_nullable_) {
-                    THROW_EXCEPTION("Field '%s' is not nullable.", field_name_.c_str());
-                }
+        } else if (field_value == Py_None) {
+            if (!is_nullable_) {
+                THROW_EXCEPTION("Field '%s' is not nullable.", field_name_.c_str());
+            }
 
-                writer.writeArrayNull();
-            } else {
-                THROW_EXCEPTION("Wrong type of field '%s'. Required: ARRAY.", field_name_.c_str());
+            writer.writeArrayNull();
+        } else if (PyUnicode_Check(field_value) || PyBytes_Check(field_value) || PyByteArray_Check(field_value)) {
+            THROW_EXCEPTION("Wrong type of field '%s'. Required: ARRAY.", field_name_.c_str());
+        } else if (PyObject_CheckBuffer(field_value) || PySequence_Check(field_value)) {
+            // numeric buffers (numpy arrays, array.array, typed memoryviews) are read without python objects
+            ColumnSource elements(field_name_, field_value);
+            if (elements.isNumeric() && !matchesElements(elements)) {
+                THROW_EXCEPTION("Wrong type of field '%s'. Required: ARRAY, format of buffer doesn't match type of elements.",
+                    field_name_.c_str());
             }
+
+            size_t size = elements.size();
+
+            writer.writeArrayStart((int32_t) size);
+            for (size_t i = 0; i < size; i++) {
+                element_codec_->encodeColumn(elements, i, writer);
+            }
+            writer.writeArrayEnd();
+        } else {
+            THROW_EXCEPTION("Wrong type of field '%s'. Required: ARRAY.", field_name_.c_str());
         }
     }
 
 private:
+    // buffers are encoded only, if their items have the same type as elements
+    bool matchesElements(const ColumnSource &elements) {
+        switch (element_codec_->getEncodeColumnType()) {
+        case INT64_COLUMN:
+            return elements.isInteger();
+        case FLOAT64_COLUMN:
+            return elements.isFloat();
+        case BOOLEAN_COLUMN:
+            return elements.isBoolean();
+        default:
+            return false;
+        }
+    }
+
+    // returns typed memoryview of elements, integer and boolean arrays with nulls are returned as lists
+    PyObject * decodeTyped(DxApi::DataReader &reader, int32_t len) {
+        elements_->clear();
+        for (int i = 0; i < len; ++i)
+            element_codec_->decodeColumn(reader, *elements_);
+        reader.readArrayEnd();
+
+        const std::vector<uint8_t> &nulls = elements_->getNulls();
+        bool has_nulls = std::find(nulls.begin(), nulls.end(), 1) != nulls.end();
+        if (!has_nulls || elements_->getType() == FLOAT64_COLUMN)
+            return elements_->valuesToPython();
+
+        PyObject *list = PyList_New(len);
+        for (int i = 0; i < len; ++i)
+            PyList_SET_ITEM(list, i, elements_->valueToPython(i));
+        return list;
+    }
+
     FieldCodecPtr element_codec_;
+
+    // buffer of decoded elements, if arrays of numeric elements are decoded to typed memoryviews
+    bool typed_arrays_ = false;
+    std::unique_ptr<Column> elements_;
 };
 
 class ObjectFieldCodec : public FieldCodec {
@@ -1074,7 +1634,34 @@ public:
         return object;
     }
 
-    inline void encode(PyObject *message, DxApi::DataWriter &writer) {
+    inline void skip(DxApi::DataReader &reader) {
+        int32_t type_id = reader.readObjectStart();
+        if (type_id == DxApi::Constants::INT32_NULL)
+            return;
+
+        if (type_id < 0 || type_id >= codecs_.size())
+            THROW_EXCEPTION("Can't find codec of type id '%d' for field: %s.", type_id, field_name_.c_str());
+
+        codecs_[type_id]->skip(reader);
+        reader.readObjectEnd();
+    }
+
+    void setDecimalOptions(const DecimalOptions &options) {
+        for (const MessageCodecPtr &codec : codecs_)
+            codec->setDecimalOptions(options);
+    }
+
+    void setTypedArrays(bool typed) {
+        for (const MessageCodecPtr &codec : codecs_)
+            codec->setTypedArrays(typed);
+    }
+
+    void setBinaryViews(bool views) {
+        for (const MessageCodecPtr &codec : codecs_)
+            codec->setBinaryViews(views);
+    }
+
+    inline void encode(PyObject *message, FieldWriter &writer) {
         if (message == NULL || message == Py_None) {
             if (!is_nullable_) {
                 THROW_EXCEPTION("Field '%s' is not nullable.", field_name_.c_str());
@@ -1,10 +1,14 @@
 #include "message_codec.h"
 
 #include "field_codecs.h"
+#include "attribute_reader.h"
+
+#include "structmember.h"
 
 #include <cstring>
 #include <algorithm>
 #include <string> 
+#include <typeinfo>
 
 namespace TbApiImpl {
 namespace Python {
@@ -20,34 +24,326 @@ MessageCodec::MessageCodec(PythonTbApiModule *tbapi_module, const ClassDescripto
 }
 
 MessageCodec::~MessageCodec() {
+    Py_XDECREF(message_class_);
+}
+
+static inline PyObject ** getSlot(PyObject *object, Py_ssize_t offset) {
+    return (PyObject **) ((char *) object + offset);
+}
+
+// operations of decode plan, CODEC is a concrete final class of step or FieldCodec for virtual calls
+struct DecodeObjectOperation {
+    DxApi::DataReader &reader;
+    PyObject *result;
+
+    template <typename CODEC>
+    inline void apply(FieldCodec *codec) {
+        result = static_cast<CODEC *>(codec)->decode(reader);
+    }
+};
+
+struct DecodeColumnOperation {
+    DxApi::DataReader &reader;
+    Column &column;
+
+    template <typename CODEC>
+    inline void apply(FieldCodec *codec) {
+        static_cast<CODEC *>(codec)->decodeColumn(reader, column);
+    }
+};
+
+struct SkipOperation {
+    DxApi::DataReader &reader;
+
+    template <typename CODEC>
+    inline void apply(FieldCodec *codec) {
+        static_cast<CODEC *>(codec)->skip(reader);
+    }
+};
+
+template <typename OPERATION>
+static FORCE_INLINE void applyStep(const DecodeStep &step, OPERATION &operation) {
+    switch (step.kind) {
+    case DECODE_INT8: return operation.template apply<IntegerFieldCodec<8>>(step.codec);
+    case DECODE_INT16: return operation.template apply<IntegerFieldCodec<16>>(step.codec);
+    case DECODE_UINT30: return operation.template apply<IntegerFieldCodec<30>>(step.codec);
+    case DECODE_INT32: return operation.template apply<IntegerFieldCodec<32>>(step.codec);
+    case DECODE_INT48: return operation.template apply<IntegerFieldCodec<48>>(step.codec);
+    case DECODE_UINT61: return operation.template apply<IntegerFieldCodec<61>>(step.codec);
+    case DECODE_INT64: return operation.template apply<IntegerFieldCodec<64>>(step.codec);
+    case DECODE_FLOAT32: return operation.template apply<FloatFieldCodec<32>>(step.codec);
+    case DECODE_DECIMAL: return operation.template apply<FloatFieldCodec<63>>(step.codec);
+    case DECODE_FLOAT64: return operation.template apply<FloatFieldCodec<64>>(step.codec);
+    case DECODE_ENUM8: return operation.template apply<EnumFieldCodec<8>>(step.codec);
+    case DECODE_ENUM16: return operation.template apply<EnumFieldCodec<16>>(step.codec);
+    case DECODE_ENUM32: return operation.template apply<EnumFieldCodec<32>>(step.codec);
+    case DECODE_ENUM64: return operation.template apply<EnumFieldCodec<64>>(step.codec);
+    default: return operation.template apply<FieldCodec>(step.codec);
+    }
+}
+
+static DecodeKind getDecodeKind(FieldCodec *codec) {
+    const std::type_info &type = typeid(*codec);
+    if (type == typeid(IntegerFieldCodec<8>))
+        return DECODE_INT8;
+    else if (type == typeid(IntegerFieldCodec<16>))
+        return DECODE_INT16;
+    else if (type == typeid(IntegerFieldCodec<30>))
+        return DECODE_UINT30;
+    else if (type == typeid(IntegerFieldCodec<32>))
+        return DECODE_INT32;
+    else if (type == typeid(IntegerFieldCodec<48>))
+        return DECODE_INT48;
+    else if (type == typeid(IntegerFieldCodec<61>))
+        return DECODE_UINT61;
+    else if (type == typeid(IntegerFieldCodec<64>))
+        return DECODE_INT64;
+    else if (type == typeid(FloatFieldCodec<32>))
+        return DECODE_FLOAT32;
+    else if (type == typeid(FloatFieldCodec<63>))
+        return DECODE_DECIMAL;
+    else if (type == typeid(FloatFieldCodec<64>))
+        return DECODE_FLOAT64;
+    else if (type == typeid(EnumFieldCodec<8>))
+        return DECODE_ENUM8;
+    else if (type == typeid(EnumFieldCodec<16>))
+        return DECODE_ENUM16;
+    else if (type == typeid(EnumFieldCodec<32>))
+        return DECODE_ENUM32;
+    else if (type == typeid(EnumFieldCodec<64>))
+        return DECODE_ENUM64;
+
+    return DECODE_VIRTUAL;
 }
 
 void MessageCodec::decode(PyObject *message, DxApi::DataReader &reader) {
-    for (int i = 0; i < field_codecs_.size(); ++i) {
-        PythonRefHolder object(field_codecs_[i]->decode(reader));
-        PyObject_SetAttr(message, field_codecs_[i]->getKey(), object.getReference());
+    bool typed = message_class_ != NULL && Py_TYPE(message) == (PyTypeObject *) message_class_;
+    for (const DecodeStep &step : decode_plan_) {
+        if (!step.selected) {
+            SkipOperation skip = { reader };
+            applyStep(step, skip);
+            continue;
+        }
+
+        DecodeObjectOperation operation = { reader, NULL };
+        applyStep(step, operation);
+        if (typed && step.slot_offset != 0) {
+            // slot owns new reference
+            PyObject **slot = getSlot(message, step.slot_offset);
+            PyObject *previous = *slot;
+            *slot = operation.result;
+            Py_XDECREF(previous);
+            continue;
+        }
+
+        PythonRefHolder object(operation.result);
+        PyObject_SetAttr(message, step.codec->getKey(), object.getReference());
     }
 }
 
-void MessageCodec::encode(PyObject *message, DxApi::DataWriter &writer) {
-    for (int i = 0; i < field_codecs_.size(); ++i) {
-        if (!PyObject_HasAttr(message, field_codecs_[i]->getKey())) {
+AttributeReader & MessageCodec::getAttributeReader() {
+    if (attribute_reader_ == nullptr) {
+        std::vector<PyObject *> keys;
+        for (const FieldCodecPtr &field_codec : field_codecs_)
+            keys.push_back(field_codec->getKey());
+        attribute_reader_.reset(new AttributeReader(keys));
+    }
+
+    return *attribute_reader_;
+}
+
+void MessageCodec::encode(PyObject *message, FieldWriter &writer) {
+    // absent attributes are encoded as nulls
+    AttributeAccessor attributes(getAttributeReader(), message);
+    for (size_t i = 0; i < field_codecs_.size(); ++i) {
+        PythonRefHolder object(attributes.get(i));
+        field_codecs_[i]->encode(object.getReference() != NULL ? object.getReference() : Py_None, writer);
+    }
+}
+
+PyObject * MessageCodec::getValues(PyObject *message) {
+    PyObject *values = PyTuple_New((Py_ssize_t) field_codecs_.size());
+    if (values == NULL)
+        THROW("Can't create tuple of field values.");
+
+    AttributeAccessor attributes(getAttributeReader(), message);
+    for (size_t i = 0; i < field_codecs_.size(); ++i) {
+        PyObject *object = attributes.get(i);
+        if (object == NULL) {
+            object = Py_None;
+            Py_INCREF(object);
+        }
+        PyTuple_SET_ITEM(values, (Py_ssize_t) i, object);
+    }
+
+    return values;
+}
+
+void MessageCodec::validateValues(PyObject *values) {
+    FieldWriter validator(NULL);
+    encodeValues(values, validator);
+}
+
+void MessageCodec::encodeValues(PyObject *values, DxApi::DataWriter &writer) {
+    FieldWriter field_writer(&writer);
+    encodeValues(values, field_writer);
+}
+
+void MessageCodec::encodeValues(PyObject *values, FieldWriter &writer) {
+    for (size_t i = 0; i < field_codecs_.size(); ++i)
+        field_codecs_[i]->encode(PyTuple_GET_ITEM(values, (Py_ssize_t) i), writer);
+}
+
+void MessageCodec::validate(const std::vector<const ColumnSource *> &sources, size_t row) {
+    FieldWriter validator(NULL);
+    encode(sources, row, validator);
+}
+
+void MessageCodec::encode(const std::vector<const ColumnSource *> &sources, size_t row, DxApi::DataWriter &writer) {
+    FieldWriter field_writer(&writer);
+    encode(sources, row, field_writer);
+}
+
+void MessageCodec::encode(const std::vector<const ColumnSource *> &sources, size_t row, FieldWriter &writer) {
+    for (size_t i = 0; i < field_codecs_.size(); ++i) {
+        if (sources[i] != NULL)
+            field_codecs_[i]->encodeColumn(*sources[i], row, writer);
+        else
             field_codecs_[i]->encode(Py_None, writer);
-            continue;
+    }
+}
+
+size_t MessageCodec::getFieldsCount() const {
+    return field_codecs_.size();
+}
+
+const char * MessageCodec::getFieldName(size_t index) const {
+    return field_codecs_[index]->getFieldName();
+}
+
+void MessageCodec::decode(DxApi::DataReader &reader, ColumnBatch &batch) {
+    if (bound_batch_id_ != batch.getId())
+        bindColumns(batch);
+
+    for (size_t i = 0; i < decode_plan_.size(); ++i) {
+        Column *column = bound_columns_[i];
+        if (column != NULL) {
+            DecodeColumnOperation operation = { reader, *column };
+            applyStep(decode_plan_[i], operation);
+        } else {
+            SkipOperation skip = { reader };
+            applyStep(decode_plan_[i], skip);
         }
+    }
+}
+
+bool MessageCodec::decodesObjects(ColumnBatch &batch) {
+    if (bound_batch_id_ != batch.getId())
+        bindColumns(batch);
+
+    return bound_objects_;
+}
+
+void MessageCodec::skip(DxApi::DataReader &reader) {
+    SkipOperation skip = { reader };
+    for (const DecodeStep &step : decode_plan_)
+        applyStep(step, skip);
+}
+
+void MessageCodec::setFields(const std::unordered_set<std::string> *fields) {
+    for (DecodeStep &step : decode_plan_)
+        step.selected = fields == NULL || fields->find(step.codec->getFieldName()) != fields->end();
+}
+
+PyObject * MessageCodec::newTypedMessage() {
+    if (message_class_ == NULL)
+        buildMessageClass();
+
+    return PyObject_CallObject(message_class_, NULL);
+}
+
+void MessageCodec::buildMessageClass() {
+    if (tbapi_module_ == NULL)
+        THROW("DxApi module is not initialized for message codec.");
+
+    PyObject *base_class = tbapi_module_->getTypedMessageClass();
+
+    // header fields have slots in base class
+    std::unordered_set<std::string> names = { TIMESTAMP_PROPERTY, SYMBOL_PROPERTY, TYPE_ID_PROPERTY, TYPE_NAME_PROPERTY };
+    PythonRefHolder slots(PyList_New(0));
+    for (const FieldCodecPtr &field_codec : field_codecs_) {
+        if (names.insert(field_codec->getFieldName()).second)
+            PyList_Append(slots.getReference(), field_codec->getKey());
+    }
+
+    size_t name_start = class_name_.rfind('.');
+    std::string name = name_start != std::string::npos ? class_name_.substr(name_start + 1) : class_name_;
+
+    PythonRefHolder bases(PyTuple_Pack(1, base_class));
+    PythonRefHolder dict(Py_BuildValue("{s:O,s:s}", "__slots__", slots.getReference(), "__module__", MODULE_NAME.c_str()));
+    message_class_ = PyObject_CallFunction((PyObject *) &PyType_Type, "sOO",
+        name.empty() ? "Message" : name.c_str(), bases.getReference(), dict.getReference());
+
+    if (message_class_ == NULL) {
+        // field names, which are not python identifiers, can't be slots: fields are stored in __dict__
+        PyErr_Clear();
+        Py_INCREF(base_class);
+        message_class_ = base_class;
+    }
+
+    PyObject *class_dict = ((PyTypeObject *) message_class_)->tp_dict;
+    for (DecodeStep &step : decode_plan_) {
+        PyObject *descriptor = class_dict != NULL ? PyDict_GetItem(class_dict, step.codec->getKey()) : NULL;
+        bool is_slot = descriptor != NULL && Py_TYPE(descriptor) == &PyMemberDescr_Type;
+        step.slot_offset = is_slot ? ((PyMemberDescrObject *) descriptor)->d_member->offset : 0;
+    }
+}
+
+void MessageCodec::setDecimalOptions(const DecimalOptions &options) {
+    for (const FieldCodecPtr &field_codec : field_codecs_)
+        field_codec->setDecimalOptions(options);
+}
+
+void MessageCodec::setTypedArrays(bool typed) {
+    for (const FieldCodecPtr &field_codec : field_codecs_)
+        field_codec->setTypedArrays(typed);
+}
+
+void MessageCodec::setBinaryViews(bool views) {
+    for (const FieldCodecPtr &field_codec : field_codecs_)
+        field_codec->setBinaryViews(views);
+}
 
-        PythonRefHolder object(PyObject_GetAttr(message, field_codecs_[i]->getKey()));
-        field_codecs_[i]->encode(object.getReference(), writer);
+void MessageCodec::bindColumns(ColumnBatch &batch) {
+    bound_columns_.clear();
+    bound_objects_ = false;
+    for (int i = 0; i < field_codecs_.size(); ++i) {
+        Column *column = batch.getColumn(field_codecs_[i]->getFieldName(), field_codecs_[i]->getColumnType());
+        if (column != NULL) {
+            field_codecs_[i]->initColumn(*column);
+            if (column->getType() == OBJECT_COLUMN)
+                bound_objects_ = true;
+        }
+        bound_columns_.push_back(column);
     }
+    bound_batch_id_ = batch.getId();
 }
 
 void MessageCodec::buildDecoders(const ClassDescriptors &descriptors, intptr_t num) {
     if (descriptors.size() <= 0)
         return;
 
+    class_name_ = descriptors[num].className;
+
     std::vector<Schema::FieldInfo> fields;
     collectFields(fields, descriptors, num);
     field_codecs_ = buildFieldDecoders(fields, descriptors);
+
+    decode_plan_.clear();
+    for (const FieldCodecPtr &field_codec : field_codecs_) {
+        DecodeStep step = { getDecodeKind(field_codec.get()), true, 0, field_codec.get() };
+        decode_plan_.push_back(step);
+    }
 }
 
 void MessageCodec::collectFields(std::vector<Schema::FieldInfo> &fields, const ClassDescriptors &descriptors, intptr_t index) {
@@ -81,6 +377,66 @@ std::vector<FieldCodecPtr> MessageCodec::buildFieldDecoders(
     return field_codecs;
 }
 
+// integer, float and enum codecs are specialized by size of value,
+// fields of unknown sizes fail when they are decoded or encoded, not when schema is loaded
+static FieldCodecPtr createIntegerFieldCodec(
+    const char *field_name, FieldValueCodec<int64_t> *relative_to, int size, bool is_nullable)
+{
+    switch (size) {
+    case 8:
+        return FieldCodecPtr(new IntegerFieldCodec<8>(field_name, relative_to, is_nullable));
+    case 16:
+        return FieldCodecPtr(new IntegerFieldCodec<16>(field_name, relative_to, is_nullable));
+    case 30:
+        return FieldCodecPtr(new IntegerFieldCodec<30>(field_name, relative_to, is_nullable));
+    case 32:
+        return FieldCodecPtr(new IntegerFieldCodec<32>(field_name, relative_to, is_nullable));
+    case 48:
+        return FieldCodecPtr(new IntegerFieldCodec<48>(field_name, relative_to, is_nullable));
+    case 61:
+        return FieldCodecPtr(new IntegerFieldCodec<61>(field_name, relative_to, is_nullable));
+    case 64:
+        return FieldCodecPtr(new IntegerFieldCodec<64>(field_name, relative_to, is_nullable));
+    default:
+        return FieldCodecPtr(new UnsupportedFieldCodec(field_name,
+            string_format("Unknow size of integer: %d.", size), is_nullable));
+    }
+}
+
+static FieldCodecPtr createFloatFieldCodec(
+    const char *field_name, FieldValueCodec<double> *relative_to, int size, bool is_nullable)
+{
+    switch (size) {
+    case 32:
+        return FieldCodecPtr(new FloatFieldCodec<32>(field_name, relative_to, is_nullable));
+    case 63:
+        return FieldCodecPtr(new FloatFieldCodec<63>(field_name, relative_to, is_nullable));
+    case 64:
+        return FieldCodecPtr(new FloatFieldCodec<64>(field_name, relative_to, is_nullable));
+    default:
+        return FieldCodecPtr(new UnsupportedFieldCodec(field_name,
+            string_format("Unknow size of float: %d.", size), is_nullable));
+    }
+}
+
+static FieldCodecPtr createEnumFieldCodec(
+    const char *field_name, const Schema::TickDbClassDescriptor &descriptor, bool is_nullable)
+{
+    switch (descriptor.enumType) {
+    case Schema::FieldTypeEnum::ENUM8:
+        return FieldCodecPtr(new EnumFieldCodec<8>(field_name, descriptor, is_nullable));
+    case Schema::FieldTypeEnum::ENUM16:
+        return FieldCodecPtr(new EnumFieldCodec<16>(field_name, descriptor, is_nullable));
+    case Schema::FieldTypeEnum::ENUM32:
+        return FieldCodecPtr(new EnumFieldCodec<32>(field_name, descriptor, is_nullable));
+    case Schema::FieldTypeEnum::ENUM64:
+        return FieldCodecPtr(new EnumFieldCodec<64>(field_name, descriptor, is_nullable));
+    default:
+        return FieldCodecPtr(new UnsupportedFieldCodec(field_name,
+            string_format("Unknow type of enum for '%s' field.", field_name), is_nullable));
+    }
+}
+
 FieldCodecPtr MessageCodec::createFieldCodec(
     Schema::DataType &data_type, std::string &field_name, std::string &relative_to, const ClassDescriptors &descriptors)
 {
@@ -96,71 +452,68 @@ FieldCodecPtr MessageCodec::createFieldCodec(
         return FieldCodecPtr(new Decimal64FieldCodec(field_name.c_str(), data_type.isNullable));
     }
     else if (!temptype.compare(0, strlen("decimal"), "decimal")) {
-        return FieldCodecPtr(new FloatFieldCodec(field_name.c_str(),
-            findRelativeTo<FloatFieldCodec *>(relative_to),
-            63, data_type.isNullable));
+        return createFloatFieldCodec(field_name.c_str(),
+            findRelativeTo<FieldValueCodec<double> *>(relative_to),
+            63, data_type.isNullable);
     }
     else if (strcmp("ieee32", cmpr) == 0) {
-        return FieldCodecPtr(new FloatFieldCodec(field_name.c_str(),
-            findRelativeTo<FloatFieldCodec *>(relative_to),
-            32, data_type.isNullable));
+        return createFloatFieldCodec(field_name.c_str(),
+            findRelativeTo<FieldValueCodec<double> *>(relative_to),
+            32, data_type.isNullable);
     }
     else if (strcmp("ieee64", cmpr) == 0) {
-        return FieldCodecPtr(new FloatFieldCodec(field_name.c_str(),
-            findRelativeTo<FloatFieldCodec *>(relative_to),
-            64, data_type.isNullable));
+        return createFloatFieldCodec(field_name.c_str(),
+            findRelativeTo<FieldValueCodec<double> *>(relative_to),
+            64, data_type.isNullable);
     } else if (temptype.rfind("binary(", 0) == 0) {
-        return FieldCodecPtr(new FloatFieldCodec(field_name.c_str(),
-            findRelativeTo<FloatFieldCodec *>(relative_to),
-            atoi(temptype.substr(strlen("binary(")).c_str()), data_type.isNullable)
-        );
+        return createFloatFieldCodec(field_name.c_str(),
+            findRelativeTo<FieldValueCodec<double> *>(relative_to),
+            atoi(temptype.substr(strlen("binary(")).c_str()), data_type.isNullable);
     }
     else if (strcmp("int8", cmpr) == 0) {
-        return FieldCodecPtr(new IntegerFieldCodec(field_name.c_str(),
-            findRelativeTo<IntegerFieldCodec *>(relative_to),
-            8, data_type.isNullable));
+        return createIntegerFieldCodec(field_name.c_str(),
+            findRelativeTo<FieldValueCodec<int64_t> *>(relative_to),
+            8, data_type.isNullable);
     }
     else if (strcmp("int16", cmpr) == 0) {
-        return FieldCodecPtr(new IntegerFieldCodec(field_name.c_str(),
-            findRelativeTo<IntegerFieldCodec *>(relative_to),
-            16, data_type.isNullable));
+        return createIntegerFieldCodec(field_name.c_str(),
+            findRelativeTo<FieldValueCodec<int64_t> *>(relative_to),
+            16, data_type.isNullable);
     }
     else if (strcmp("int32", cmpr) == 0) {
-        return FieldCodecPtr(new IntegerFieldCodec(field_name.c_str(),
-            findRelativeTo<IntegerFieldCodec *>(relative_to),
-            32, data_type.isNullable));
+        return createIntegerFieldCodec(field_name.c_str(),
+            findRelativeTo<FieldValueCodec<int64_t> *>(relative_to),
+            32, data_type.isNullable);
     }
     else if (strcmp("int48", cmpr) == 0) {
-        return FieldCodecPtr(new IntegerFieldCodec(field_name.c_str(),
-            findRelativeTo<IntegerFieldCodec *>(relative_to),
-            48, data_type.isNullable));
+        return createIntegerFieldCodec(field_name.c_str(),
+            findRelativeTo<FieldValueCodec<int64_t> *>(relative_to),
+            48, data_type.isNullable);
     }
     else if (strcmp("int64", cmpr) == 0) {
-        return FieldCodecPtr(new IntegerFieldCodec(field_name.c_str(),
-            findRelativeTo<IntegerFieldCodec *>(relative_to),
-            64, data_type.isNullable));
+        return createIntegerFieldCodec(field_name.c_str(),
+            findRelativeTo<FieldValueCodec<int64_t> *>(relative_to),
+            64, data_type.isNullable);
     } 
     else if (temptype.rfind("signed(", 0) == 0) {
-        return FieldCodecPtr(new IntegerFieldCodec(field_name.c_str(),
-            findRelativeTo<IntegerFieldCodec *>(relative_to),
-            atoi(temptype.substr(strlen("signed(")).c_str()), data_type.isNullable)
-        );
+        return createIntegerFieldCodec(field_name.c_str(),
+            findRelativeTo<FieldValueCodec<int64_t> *>(relative_to),
+            atoi(temptype.substr(strlen("signed(")).c_str()), data_type.isNullable);
     }
     else if (strcmp("puint30", cmpr) == 0) {
-        return FieldCodecPtr(new IntegerFieldCodec(field_name.c_str(),
-            findRelativeTo<IntegerFieldCodec *>(relative_to),
-            30, data_type.isNullable));
+        return createIntegerFieldCodec(field_name.c_str(),
+            findRelativeTo<FieldValueCodec<int64_t> *>(relative_to),
+            30, data_type.isNullable);
     }
     else if (strcmp("puint61", cmpr) == 0) {
-        return FieldCodecPtr(new IntegerFieldCodec(field_name.c_str(),
-            findRelativeTo<IntegerFieldCodec *>(relative_to),
-            61, data_type.isNullable));
+        return createIntegerFieldCodec(field_name.c_str(),
+            findRelativeTo<FieldValueCodec<int64_t> *>(relative_to),
+            61, data_type.isNullable);
     } 
     else if (temptype.rfind("unsigned(", 0) == 0) {
-        return FieldCodecPtr(new IntegerFieldCodec(field_name.c_str(),
-            findRelativeTo<IntegerFieldCodec *>(relative_to),
-            atoi(temptype.substr(strlen("unsigned(")).c_str()), data_type.isNullable)
-        );
+        return createIntegerFieldCodec(field_name.c_str(),
+            findRelativeTo<FieldValueCodec<int64_t> *>(relative_to),
+            atoi(temptype.substr(strlen("unsigned(")).c_str()), data_type.isNullable);
     }
     else if (strcmp("pinterval", cmpr) == 0) {
         return FieldCodecPtr(new IntervalFieldCodec(field_name.c_str(), data_type.isNullable));
@@ -191,7 +544,7 @@ FieldCodecPtr MessageCodec::createFieldCodec(
         if (index == INT32_MIN)
             THROW_EXCEPTION("Unknown enum type: %s.", data_type.descriptorGuid.c_str());
 
-        return FieldCodecPtr(new EnumFieldCodec(field_name.c_str(), descriptors[index], data_type.isNullable));
+        return createEnumFieldCodec(field_name.c_str(), descriptors[index], data_type.isNullable);
     }
     else if (strcmp("array", cmpr) == 0) {
         if (data_type.elementType == nullptr)
@@ -7,28 +7,101 @@
 #include "data_reader.h"
 #include "data_writer.h"
 
+#include "decimal64.h"
+
 #include <algorithm>
 #include <memory>
+#include <unordered_set>
 
 namespace TbApiImpl {
 namespace Python {
 
 class FieldCodec;
+class FieldWriter;
 class PythonTbApiModule;
+class Column;
+class ColumnBatch;
+class ColumnSource;
+class AttributeReader;
 
 typedef std::vector<Schema::TickDbClassDescriptor> ClassDescriptors;
 typedef std::shared_ptr<FieldCodec> FieldCodecPtr;
 
+// concrete class of codec of step of decode plan, numeric and enum codecs are final,
+// so their calls are dispatched by switch and inlined, other codecs are called by virtual calls
+enum DecodeKind : uint8_t {
+    DECODE_INT8, DECODE_INT16, DECODE_UINT30, DECODE_INT32, DECODE_INT48, DECODE_UINT61, DECODE_INT64,
+    DECODE_FLOAT32, DECODE_DECIMAL, DECODE_FLOAT64,
+    DECODE_ENUM8, DECODE_ENUM16, DECODE_ENUM32, DECODE_ENUM64,
+    DECODE_VIRTUAL
+};
+
+struct DecodeStep {
+    DecodeKind kind;
+    bool selected;
+    // offset of slot of field in class of MessageCodec::newTypedMessage() (0 if field has no slot)
+    Py_ssize_t slot_offset;
+    FieldCodec *codec;
+};
+
 class MessageCodec {
 public:
     MessageCodec(const ClassDescriptors &descriptors, intptr_t num);
     MessageCodec(PythonTbApiModule *tbapi_module, const ClassDescriptors &descriptors, intptr_t num);
     ~MessageCodec();
 
+    // fields of messages of class returned by newTypedMessage() are decoded directly to slots
     void decode(PyObject *message, DxApi::DataReader &reader);
-    void encode(PyObject *message, DxApi::DataWriter &writer);
+
+    // fields are read with plan of python type of message (slots, __dict__ or generic attributes)
+    void encode(PyObject *message, FieldWriter &writer);
+
+    // returns new tuple of field values of message (None for absent fields), which is encoded by encodeValues
+    PyObject * getValues(PyObject *message);
+
+    // values are validated before loader starts message, so encodeValues of validated values doesn't fail
+    void validateValues(PyObject *values);
+    void encodeValues(PyObject *values, DxApi::DataWriter &writer);
+
+    // returns new message object of class with slots for fields of codec, class is created on the first call
+    PyObject * newTypedMessage();
+
+    // encodes the row of columns, sources are in order of fields, NULL sources are encoded as nulls
+    void validate(const std::vector<const ColumnSource *> &sources, size_t row);
+    void encode(const std::vector<const ColumnSource *> &sources, size_t row, DxApi::DataWriter &writer);
+
+    size_t getFieldsCount() const;
+    const char * getFieldName(size_t index) const;
+
+    // decodes fields of message to the current row of batch
+    void decode(DxApi::DataReader &reader, ColumnBatch &batch);
+
+    // true if fields are decoded to object columns of batch, which requires GIL
+    bool decodesObjects(ColumnBatch &batch);
+
+    // reads fields of message without decoding
+    void skip(DxApi::DataReader &reader);
+
+    // python objects are created only for selected fields, other fields are skipped; NULL selects all fields
+    void setFields(const std::unordered_set<std::string> *fields);
+
+    // selects python representation of decimal fields, including fields of nested objects
+    void setDecimalOptions(const DecimalOptions &options);
+
+    // decodes arrays of numeric elements to typed memoryviews instead of lists
+    void setTypedArrays(bool typed);
+
+    // decodes binary fields to read-only memoryviews instead of bytes
+    void setBinaryViews(bool views);
 
 private:
+    void bindColumns(ColumnBatch &batch);
+    void encodeValues(PyObject *values, FieldWriter &writer);
+    void encode(const std::vector<const ColumnSource *> &sources, size_t row, FieldWriter &writer);
+
+    void buildMessageClass();
+    AttributeReader & getAttributeReader();
+
     void buildDecoders(const ClassDescriptors &descriptors, intptr_t num);
 
     void collectFields(std::vector<Schema::FieldInfo> &fields, 
@@ -50,9 +123,22 @@ private:
 
 private:
     std::vector<FieldCodecPtr> field_codecs_;
+    // steps of field_codecs_ in decoding order, resolved once per schema
+    std::vector<DecodeStep> decode_plan_;
     std::unordered_map<std::string, FieldCodecPtr> codecs_search_map_;
     PythonTbApiModule *tbapi_module_ = NULL;
 
+    // subclass of TypedInstrumentMessage with slots of fields
+    std::string class_name_;
+    PyObject *message_class_ = NULL;
+
+    // reader of fields of sent messages, created on the first encoded message
+    std::unique_ptr<AttributeReader> attribute_reader_;
+
+    uint64_t bound_batch_id_ = 0;
+    std::vector<Column *> bound_columns_;
+    bool bound_objects_ = false;
+
 };
 
 typedef std::shared_ptr<MessageCodec> MessageCodecPtr;
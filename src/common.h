@@ -15,6 +15,13 @@ std::string string_format(const std::string format, ...);
 #define THROW_EXCEPTION(FORMAT, ...) \
     throw std::runtime_error(string_format(FORMAT, __VA_ARGS__));
 
+// inlines functions, which are too large for compiler heuristics, but are called from a single hot loop
+#if defined(_MSC_VER)
+#define FORCE_INLINE __forceinline
+#else
+#define FORCE_INLINE inline __attribute__((always_inline))
+#endif
+
 class MutexHolder {
 public:
     MutexHolder(std::mutex *mutex) {
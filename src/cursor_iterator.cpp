@@ -0,0 +1,82 @@
+#include "cursor_iterator.h"
+
+#include "tick_cursor.h"
+
+namespace TbApiImpl {
+namespace Python {
+
+struct CursorIteratorObject {
+    PyObject_HEAD
+    TickCursor *cursor;
+    PyObject *owner;
+};
+
+static void deallocCursorIterator(PyObject *self) {
+    CursorIteratorObject *iterator = (CursorIteratorObject *) self;
+    Py_XDECREF(iterator->owner);
+
+    PyTypeObject *type = Py_TYPE(self);
+    type->tp_free(self);
+    Py_DECREF(type);
+}
+
+static PyObject * nextCursorMessage(PyObject *self) {
+    CursorIteratorObject *iterator = (CursorIteratorObject *) self;
+    try {
+        // NULL without exception stops iteration
+        if (!iterator->cursor->next())
+            return NULL;
+
+        return iterator->cursor->getMessage();
+    } catch (const std::exception &e) {
+        PyErr_SetString(PyExc_Exception, e.what());
+        return NULL;
+    } catch (...) {
+        PyErr_SetString(PyExc_Exception, "Unknown error.");
+        return NULL;
+    }
+}
+
+static PyType_Slot CURSOR_ITERATOR_SLOTS[] = {
+    { Py_tp_dealloc, (void *) deallocCursorIterator },
+    { Py_tp_iter, (void *) PyObject_SelfIter },
+    { Py_tp_iternext, (void *) nextCursorMessage },
+#if PY_VERSION_HEX < 0x030A0000
+    { Py_tp_new, (void *) newNativeObject },
+#endif
+    { 0, NULL }
+};
+
+static PyType_Spec CURSOR_ITERATOR_SPEC = {
+    "tbapi.TickCursorIterator",
+    sizeof(CursorIteratorObject),
+    0,
+    NATIVE_TYPE_FLAGS,
+    CURSOR_ITERATOR_SLOTS
+};
+
+PyObject * newCursorIterator(TickCursor *cursor, PyObject *owner) {
+    // type is created once and never released
+    static PyObject *iterator_type = NULL;
+    if (iterator_type == NULL) {
+        iterator_type = PyType_FromSpec(&CURSOR_ITERATOR_SPEC);
+        if (iterator_type == NULL)
+            THROW("Can't create type of cursor iterator.");
+    }
+
+    CursorIteratorObject *iterator = PyObject_New(CursorIteratorObject, (PyTypeObject *) iterator_type);
+    if (iterator == NULL)
+        THROW("Can't create cursor iterator.");
+
+#if PY_VERSION_HEX < 0x03080000
+    // instances of heap types own reference to their type, newer versions take it in PyObject_New
+    Py_INCREF(iterator_type);
+#endif
+    iterator->cursor = cursor;
+    iterator->owner = owner;
+    Py_XINCREF(owner);
+    return (PyObject *) iterator;
+}
+
+}
+}
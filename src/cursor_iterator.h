@@ -0,0 +1,20 @@
+#ifndef DELTIX_API_CURSOR_ITERATOR_H_
+#define DELTIX_API_CURSOR_ITERATOR_H_
+
+#include "Python.h"
+
+#include "python_common.h"
+
+namespace TbApiImpl {
+namespace Python {
+
+class TickCursor;
+
+// Returns new native iterator over messages of cursor: tp_iternext calls next() and getMessage()
+// of cursor directly, without python shims. Iterator keeps reference to owner (python object of cursor).
+PyObject * newCursorIterator(TickCursor *cursor, PyObject *owner);
+
+}
+}
+
+#endif //DELTIX_API_CURSOR_ITERATOR_H_
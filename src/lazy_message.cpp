@@ -0,0 +1,83 @@
+#include "lazy_message.h"
+
+#include "codecs/column_batch.h"
+
+namespace TbApiImpl {
+namespace Python {
+
+static const char *CHUNK_CAPSULE_NAME = "tbapi.LazyMessageChunk";
+
+static void deleteChunk(PyObject *capsule) {
+    delete (LazyMessageChunk *) PyCapsule_GetPointer(capsule, CHUNK_CAPSULE_NAME);
+}
+
+static PyObject * accessField(PyObject *self, PyObject *args) {
+    LazyMessageChunk *chunk = (LazyMessageChunk *) PyCapsule_GetPointer(self, CHUNK_CAPSULE_NAME);
+    if (chunk == NULL)
+        return NULL;
+
+    Py_ssize_t row;
+    PyObject *name;
+    if (!PyArg_ParseTuple(args, "nO", &row, &name))
+        return NULL;
+
+    try {
+        return chunk->getField((size_t) row, name);
+    } catch (const std::exception &e) {
+        PyErr_SetString(PyExc_Exception, e.what());
+        return NULL;
+    } catch (...) {
+        PyErr_SetString(PyExc_Exception, "Unknown error.");
+        return NULL;
+    }
+}
+
+static PyMethodDef ACCESS_FIELD_METHOD = {
+    "accessField", accessField, METH_VARARGS, "Returns value of field of lazy message."
+};
+
+PyObject * LazyMessageChunk::newAccessor(LazyMessageChunk **chunk) {
+    LazyMessageChunk *new_chunk = new LazyMessageChunk();
+    PyObject *capsule = PyCapsule_New(new_chunk, CHUNK_CAPSULE_NAME, deleteChunk);
+    if (capsule == NULL) {
+        delete new_chunk;
+        THROW("Can't create capsule of lazy messages.");
+    }
+
+    PyObject *accessor = PyCFunction_New(&ACCESS_FIELD_METHOD, capsule);
+    Py_DECREF(capsule);
+    if (accessor == NULL)
+        THROW("Can't create accessor of lazy messages.");
+
+    *chunk = new_chunk;
+    return accessor;
+}
+
+LazyMessageChunk::LazyMessageChunk() : batch_(new ColumnBatch()) {
+}
+
+LazyMessageChunk::~LazyMessageChunk() {
+}
+
+PyObject * LazyMessageChunk::getField(size_t row, PyObject *name) {
+    if (row >= batch_->size())
+        THROW_EXCEPTION("Row %d is out of bounds of lazy messages.", (int) row);
+
+    if (name == Py_None)
+        return batch_->rowToPython(row);
+
+    const char *field_name = PyUnicode_AsUTF8(name);
+    if (field_name == NULL)
+        return NULL;
+
+    Column *column = batch_->findColumn(field_name);
+    if (column == NULL) {
+        PyErr_SetObject(PyExc_AttributeError, name);
+        return NULL;
+    }
+
+    return column->valueToPython(row);
+}
+
+}
+}
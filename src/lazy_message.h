@@ -0,0 +1,44 @@
+#ifndef DELTIX_API_LAZY_MESSAGE_H_
+#define DELTIX_API_LAZY_MESSAGE_H_
+
+#include "Python.h"
+
+#include "python_common.h"
+#include "dxapi.h"
+
+#include <memory>
+
+namespace TbApiImpl {
+namespace Python {
+
+class ColumnBatch;
+
+// Messages of one type decoded natively into columns (header and fields), without python objects.
+// Chunk is owned by python accessor: accessor(row, name) returns value of the field,
+// accessor(row, None) returns dictionary with all fields of the row.
+// Lazy messages keep reference to accessor, so chunk lives until the last message is released.
+class LazyMessageChunk {
+public:
+    // creates chunk and returns new reference to its accessor
+    static PyObject * newAccessor(LazyMessageChunk **chunk);
+
+    ~LazyMessageChunk();
+
+    ColumnBatch & getBatch() {
+        return *batch_;
+    }
+
+    PyObject * getField(size_t row, PyObject *name);
+
+private:
+    LazyMessageChunk();
+
+    DISALLOW_COPY_AND_ASSIGN(LazyMessageChunk);
+
+    std::unique_ptr<ColumnBatch> batch_;
+};
+
+}
+}
+
+#endif //DELTIX_API_LAZY_MESSAGE_H_
@@ -4,6 +4,16 @@ namespace TbApiImpl {
 namespace Python {
 
 bool getStringValue(PyObject *field_value, std::string &ret_value, bool &type_mismatch) {
+    const char *buffer;
+    Py_ssize_t size;
+    if (!getStringBuffer(field_value, buffer, size, type_mismatch))
+        return false;
+
+    ret_value.assign(buffer, (size_t) size);
+    return true;
+}
+
+bool getStringBuffer(PyObject *field_value, const char *&ret_value, Py_ssize_t &size, bool &type_mismatch) {
     type_mismatch = false;
     if (field_value == Py_None || field_value == NULL)
         return false;
@@ -18,12 +28,17 @@ bool getStringValue(PyObject *field_value, std::string &ret_value, bool &type_mi
     }
 
 #if PY_MAJOR_VERSION >= 3
-    PyObject* str_object = PyUnicode_AsUTF8String(field_value);  // TODO: check UTF8?
-    ret_value = PyBytes_AsString(str_object);
-    Py_XDECREF(str_object);
+    // ascii strings return their own data, other strings cache utf-8 representation on first call
+    ret_value = PyUnicode_AsUTF8AndSize(field_value, &size);
 #else
-    ret_value = PyString_AsString(field_value);  // TODO: check UTF8?
+    if (PyString_AsStringAndSize(field_value, (char **) &ret_value, &size) != 0)
+        ret_value = NULL;
 #endif
+    if (ret_value == NULL) {
+        PyErr_Clear();
+        type_mismatch = true;
+        return false;
+    }
 
     return true;
 }
@@ -173,5 +188,10 @@ bool getBooleanValue(PyObject *message, const std::string &field_name, PyObject
     return getBooleanValue(object.getReference(), ret_value);
 }
 
+PyObject * newNativeObject(PyTypeObject *type, PyObject *args, PyObject *kwargs) {
+    PyErr_Format(PyExc_TypeError, "cannot create '%s' instances", type->tp_name);
+    return NULL;
+}
+
 }
 }
\ No newline at end of file
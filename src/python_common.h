@@ -12,6 +12,8 @@ namespace Python {
 
 const std::string MODULE_NAME = "tbapi";
 const std::string MESSAGE_OBJECT_CLASS_NAME = "InstrumentMessage";
+const std::string LAZY_MESSAGE_OBJECT_CLASS_NAME = "LazyInstrumentMessage";
+const std::string TYPED_MESSAGE_OBJECT_CLASS_NAME = "TypedInstrumentMessage";
 
 const std::string TYPE_ID_PROPERTY = "typeId";
 const std::string TYPE_NAME_PROPERTY = "typeName";
@@ -24,6 +26,8 @@ const std::string TIMESTAMP_PROPERTY = "timestamp";
 //functions return false, if field_value is NULL, Py_None or type_mismatch is true
 //type_mismatch is true, when type of field_value not corresponds to return value of function
 bool getStringValue(PyObject *field_value, std::string &ret_value, bool &type_mismatch);
+// ret_value points to utf-8 buffer owned (and cached) by field_value, it's valid while field_value is alive
+bool getStringBuffer(PyObject *field_value, const char *&ret_value, Py_ssize_t &size, bool &type_mismatch);
 bool getInt32Value(PyObject *field_value, int32_t &ret_value, bool &type_mismatch);
 bool getInt64Value(PyObject *field_value, int64_t &ret_value, bool &type_mismatch);
 bool getDoubleValue(PyObject *field_value, double &ret_value, bool &type_mismatch);
@@ -35,6 +39,17 @@ bool getInt64Value(PyObject *message, const std::string &field_name, PyObject *f
 //bool getDoubleValue(PyObject *message, const std::string &field_name, PyObject *field_key, double &ret_value);
 //bool getBooleanValue(PyObject *message, const std::string &field_name, PyObject *field_key, bool &ret_value);
 
+// native types (iterators, buffers) are created only by module, python code can't create their objects,
+// since their fields are not initialized by tp_new
+#if PY_VERSION_HEX >= 0x030A0000
+#define NATIVE_TYPE_FLAGS (Py_TPFLAGS_DEFAULT | Py_TPFLAGS_DISALLOW_INSTANTIATION)
+#else
+#define NATIVE_TYPE_FLAGS Py_TPFLAGS_DEFAULT
+#endif
+
+// tp_new of native types before python 3.10, raises TypeError
+PyObject * newNativeObject(PyTypeObject *type, PyObject *args, PyObject *kwargs);
+
 //todo: should be singletone
 class PythonTbApiModule {
 public:
@@ -48,6 +63,9 @@ public:
         instrument_message_class_ = PyDict_GetItemString(module_dict_, MESSAGE_OBJECT_CLASS_NAME.c_str());
         if (instrument_message_class_ == NULL)
             THROW_EXCEPTION("Class '%32s' not found in module '%32s'.", MESSAGE_OBJECT_CLASS_NAME.c_str(), MODULE_NAME.c_str());
+
+        lazy_message_class_ = PyDict_GetItemString(module_dict_, LAZY_MESSAGE_OBJECT_CLASS_NAME.c_str());
+        typed_message_class_ = PyDict_GetItemString(module_dict_, TYPED_MESSAGE_OBJECT_CLASS_NAME.c_str());
     }
 
     ~PythonTbApiModule() {
@@ -62,10 +80,28 @@ public:
         return message_object;
     }
 
+    // lazy message reads values of the row by accessor of its chunk
+    PyObject * newLazyMessageObject(PyObject *accessor, size_t row) {
+        if (lazy_message_class_ == NULL)
+            THROW_EXCEPTION("Class '%32s' not found in module '%32s'.", LAZY_MESSAGE_OBJECT_CLASS_NAME.c_str(), MODULE_NAME.c_str());
+
+        return PyObject_CallFunction(lazy_message_class_, "On", accessor, (Py_ssize_t) row);
+    }
+
+    // borrowed reference
+    PyObject * getTypedMessageClass() {
+        if (typed_message_class_ == NULL)
+            THROW_EXCEPTION("Class '%32s' not found in module '%32s'.", TYPED_MESSAGE_OBJECT_CLASS_NAME.c_str(), MODULE_NAME.c_str());
+
+        return typed_message_class_;
+    }
+
 private:
     PyObject *tbapi_module_ = NULL;
     PyObject *module_dict_ = NULL;
     PyObject *instrument_message_class_ = NULL;
+    PyObject *lazy_message_class_ = NULL;
+    PyObject *typed_message_class_ = NULL;
 };
 
 //RAII for new reference of PyObject *
@@ -87,6 +123,31 @@ private:
     PyObject *object_;
 };
 
+//RAII for buffer exported by python object (buffer protocol), buffer is released on exit
+class PythonBufferHolder {
+public:
+    PythonBufferHolder(PyObject *object, int flags) {
+        acquired_ = PyObject_GetBuffer(object, &buffer_, flags) == 0;
+    }
+
+    ~PythonBufferHolder() {
+        if (acquired_)
+            PyBuffer_Release(&buffer_);
+    }
+
+    bool isAcquired() const {
+        return acquired_;
+    }
+
+    const Py_buffer & getBuffer() const {
+        return buffer_;
+    }
+
+private:
+    Py_buffer buffer_;
+    bool acquired_;
+};
+
 class PythonGILLockHolder {
 public:
     PythonGILLockHolder() {
@@ -101,6 +162,21 @@ private:
     PyGILState_STATE state_;
 };
 
+//RAII for releasing GIL while native code blocks (network, locks), reacquires GIL on exit (also on exception)
+class PythonGILReleaseHolder {
+public:
+    PythonGILReleaseHolder() {
+        state_ = PyEval_SaveThread();
+    }
+
+    ~PythonGILReleaseHolder() {
+        PyEval_RestoreThread(state_);
+    }
+
+private:
+    PyThreadState *state_;
+};
+
 }
 }
 
@@ -7,6 +7,161 @@ JAVA_LONG_MAX_VALUE = 9223372036854775807
 class InstrumentMessage(object):
     def __str__(self):
         return str(vars(self))
+
+class TypedInstrumentMessage(InstrumentMessage):
+    '''Base class of messages returned by TickCursor.getMessage() in typed mode (see TickCursor.setTypedMessages).
+    Cursor creates subclass with slots for fields of every message class, so fields are not stored in __dict__.
+    Other attributes can still be assigned.
+    '''
+    __slots__ = ('timestamp', 'symbol', 'typeId', 'typeName')
+
+    def __str__(self):
+        values = {}
+        for cls in reversed(type(self).__mro__):
+            for name in cls.__dict__.get('__slots__', ()):
+                if hasattr(self, name):
+                    values[name] = getattr(self, name)
+        values.update(vars(self))
+        return str(values)
+
+class LazyInstrumentMessage(InstrumentMessage):
+    '''Message returned by TickCursor.getMessage() in lazy mode (see TickCursor.setLazyMessages).
+    Header (timestamp, symbol, typeId, typeName) and fields are kept natively by the cursor
+    and are converted to python objects on the first access.
+    '''
+    __slots__ = ('_field', '_row')
+
+    def __init__(self, field, row):
+        self._field = field
+        self._row = row
+
+    def __getattr__(self, name):
+        if name in ('_row', '_field'):
+            raise AttributeError(name)
+        value = self._field(self._row, name)
+        setattr(self, name, value)
+        return value
+
+    def __str__(self):
+        values = self._field(self._row, None)
+        values.update(vars(self))
+        return str(values)
+
+class MessageBatch(object):
+    '''Messages decoded into columns by TickCursor.nextBatch.
+
+    Numeric fields (integers, floats, decimals, timestamps, booleans) are stored in typed memoryviews
+    over buffers, which decoded values of the batch are copied into,
+    enums, symbol and typeName are stored as int64 codes with list of categories,
+    strings and other fields are stored in lists.
+    Fields, that are absent in message (polymorphic streams) or null, are marked in nulls.
+
+    Example:
+        ```
+        batch = cursor.nextBatch(10000)
+        prices = batch.toNumpy()['price']
+        symbols = batch.decode('symbol')
+        ```
+    '''
+
+    def __init__(self, size, columns, nulls, categories):
+        self.size = size
+        self.columns = columns
+        self.nulls = nulls
+        self.categories = categories
+
+    def __len__(self):
+        return self.size
+
+    def __getitem__(self, name):
+        return self.columns[name]
+
+    def __contains__(self, name):
+        return name in self.columns
+
+    def keys(self):
+        return self.columns.keys()
+
+    def decode(self, name: str) -> list:
+        '''Returns values of column as list, null values are returned as None.'''
+        values = self.columns[name]
+        nulls = self.nulls[name]
+        categories = self.categories.get(name)
+        if categories is None:
+            return [None if nulls[i] else values[i] for i in range(self.size)]
+        else:
+            return [None if nulls[i] else categories[values[i]] for i in range(self.size)]
+
+    def toNumpy(self) -> dict:
+        '''Returns dictionary of numpy arrays (requires numpy).
+        Arrays of numeric columns share buffers of memoryviews, values are not copied again.'''
+        import numpy
+        return {name: numpy.asarray(values) for (name, values) in self.columns.items()}
+
+    def toDict(self) -> dict:
+        '''Returns dictionary of columns ready for pandas.DataFrame.
+
+        If numpy is available, numeric columns are numpy arrays: nulls of float columns are NaN,
+        integer columns with nulls are converted to float64 with NaN.
+        Other columns (and all columns without numpy) are lists with None for null values.
+        '''
+        try:
+            import numpy
+        except ImportError:
+            return {name: self.decode(name) for name in self.columns}
+
+        table = {}
+        for (name, values) in self.columns.items():
+            if name in self.categories or not isinstance(values, memoryview):
+                table[name] = self.decode(name)
+                continue
+
+            array = numpy.asarray(values)
+            nulls = numpy.asarray(self.nulls[name])
+            if nulls.any():
+                if array.dtype == numpy.bool_:
+                    table[name] = self.decode(name)
+                    continue
+                if array.dtype != numpy.float64:
+                    array = array.astype(numpy.float64)
+                    array[nulls] = numpy.nan
+            table[name] = array
+        return table
+
+class ArrowBatch(object):
+    '''Messages exported by TickCursor.nextArrowBatch with Arrow C Data Interface.
+
+    The batch is a struct array (record batch) with a column per field: integers, timestamps, floats, decimals
+    and booleans are exported as arrow primitive arrays (numeric buffers are not copied),
+    strings as utf8 arrays, enums, symbol and typeName as dictionary-encoded arrays, arrays as lists.
+    Columns of objects, arrays of objects, binary and char fields are not exported.
+    The batch implements Arrow PyCapsule Interface and can be imported only once.
+
+    Example:
+        ```
+        batch = cursor.nextArrowBatch(10000)
+        records = pyarrow.record_batch(batch)
+        ```
+    '''
+
+    def __init__(self, size, capsules):
+        self.size = size
+        self.__capsules = capsules
+
+    def __len__(self):
+        return self.size
+
+    def __arrow_c_array__(self, requested_schema=None):
+        if self.__capsules is None:
+            raise Exception('Arrow batch is already imported.')
+        capsules = self.__capsules
+        self.__capsules = None
+        return capsules
+
+    def toPyArrow(self):
+        '''Imports batch into pyarrow.RecordBatch (requires pyarrow 14 or later).'''
+        import pyarrow
+        return pyarrow.record_batch(self)
 %}
 
 #include <string>
@@ -378,6 +378,15 @@ typedef int64_t TimestampNs;
 	);
 }
 
+// cursors are created by methods with selection options, cursor keeps live flag of options
+%typemap(argout) const DxApi::SelectionOptions &options {
+
+	/* %typemap(argout) const DxApi::SelectionOptions &options */
+	void *cursor_ptr = NULL;
+	if (SWIG_IsOK(SWIG_ConvertPtr($result, &cursor_ptr, SWIGTYPE_p_TbApiImpl__Python__TickCursor, 0)) && cursor_ptr != NULL)
+		((TbApiImpl::Python::TickCursor *) cursor_ptr)->setLive($1->live);
+}
+
 %typemap(out) DxApi::TickLoader * {
 
 	/* %typemap(out) DxApi::TickLoader * */
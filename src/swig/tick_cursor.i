@@ -34,6 +34,8 @@ public:
         '''Moves cursor on to the next message. This method blocks until the next message becomes available,
         or until the cursor is determined to be at the end of the sequence.
         This method is illegal to call if isAtEnd() returns true.
+        Other python threads are not blocked while cursor waits for the message,
+        but the same cursor should not be used from several threads simultaneously.
 
         Returns:
             bool: false if at the end of the cursor.
@@ -44,6 +46,146 @@ public:
         '''Returns an InstrumentMessage object cursor points at.'''
         return self.__getMessage()
 
+    def __iter__(self) -> 'Iterator[InstrumentMessage]':
+        '''Returns native iterator over the remaining messages of the cursor:
+
+        ```
+        for message in cursor:
+            print(message.symbol)
+        ```
+
+        Every step calls next() and getMessage() natively, so returned messages are the same
+        as getMessage() returns (reused InstrumentMessage objects, unless lazy mode is enabled).
+        '''
+        return self.__iterator(self)
+
+    def nextBatch(self, maxMessages: int = 10000) -> 'MessageBatch':
+        '''Reads up to maxMessages next messages and decodes them into columns.
+        This method blocks like next() and returns smaller batch at the end of the cursor.
+        Columns are much cheaper than per-message InstrumentMessage objects,
+        note that getMessage() is not updated by this method.
+
+        Args:
+            maxMessages (int): max number of messages in batch.
+
+        Returns:
+            MessageBatch: decoded messages, empty batch if cursor is at the end.
+        '''
+        return MessageBatch(*self.__nextBatch(maxMessages))
+
+    def nextArrowBatch(self, maxMessages: int = 10000) -> 'ArrowBatch':
+        '''Reads up to maxMessages next messages and exports them with Arrow C Data Interface,
+        so pyarrow, polars or DuckDB can consume them without per-message python objects.
+        Like nextBatch(), this method blocks and returns smaller batch at the end of the cursor.
+
+        Args:
+            maxMessages (int): max number of messages in batch.
+
+        Returns:
+            ArrowBatch: exported messages, empty batch if cursor is at the end.
+        '''
+        return ArrowBatch(*self.__nextArrowBatch(maxMessages))
+
+    def readColumns(self, fields: 'list[str]' = None) -> 'MessageBatch':
+        '''Reads all remaining messages of the cursor and decodes them into columns.
+        Fields, which are not in the list, are skipped without decoding.
+
+        Args:
+            fields (list[str]): names of fields to read, fields selected with setFields() are read if None.
+                Header (timestamp, symbol, typeId, typeName) is always read.
+
+        Returns:
+            MessageBatch: decoded messages.
+        '''
+        return MessageBatch(*self.__readColumns(fields))
+
+    def setFields(self, fields: 'list[str]') -> None:
+        '''Selects fields to decode. getMessage() and nextBatch() return only selected fields
+        (plus header: timestamp, symbol, typeId and typeName), other fields are skipped without decoding.
+        Message objects are recreated after this call, so they don't keep attributes of unselected fields.
+
+        Args:
+            fields (list[str]): names of fields to decode, all fields are decoded if None.
+        '''
+        self.__setFields(fields)
+
+    def setLazyMessages(self, lazy: bool) -> None:
+        '''Enables lazy mode: getMessage() returns new LazyInstrumentMessage for every message.
+        next() reads header and fields natively without python objects, message object is created by getMessage()
+        and its values are converted to python objects only when they are accessed,
+        so skipped messages and messages filtered by symbol or typeName are cheap.
+        Lazy messages stay valid after the cursor moves on.
+
+        Args:
+            lazy (bool): True to enable lazy mode, False to return reused InstrumentMessage objects.
+        '''
+        self.__setLazyMessages(lazy)
+
+    def setTypedMessages(self, typed: bool) -> None:
+        '''Enables typed mode: getMessage() returns objects of classes generated for every message class
+        of the stream (subclasses of TypedInstrumentMessage), which store fields in slots instead of __dict__.
+        Fields are written to slots directly, so decoding is faster and retained messages take less memory.
+
+        Args:
+            typed (bool): True to return typed messages, False to return InstrumentMessage objects.
+        '''
+        self.__setTypedMessages(typed)
+
+    def setPrefetch(self, depth: int, batchSize: int = 1024) -> None:
+        '''Enables prefetching for historical cursors (live cursors are rejected): background thread reads and decodes
+        up to depth batches of batchSize messages ahead, while python processes previous batch.
+        nextBatch() and nextArrowBatch() return prefetched batches of batchSize messages
+        (their maxMessages argument is ignored). Prefetched messages are decoded only to columns,
+        so next(), nextIfAvailable(), readColumns(), getMessage(), getCurrentStreamKey(),
+        setLazyMessages() and setTypedMessages() are not available.
+        Prefetching is restarted after reset or change of subscription,
+        batches, which are prefetched but not returned yet, are discarded when prefetching is disabled.
+
+        Args:
+            depth (int): number of batches to read ahead, 0 disables prefetching.
+            batchSize (int): number of messages in prefetched batch.
+        '''
+        self.__setPrefetch(depth, batchSize)
+
+    def setDecimalMode(self, mode: str, scale: int = 0, fieldScales: 'dict[str, int]' = None) -> None:
+        '''Selects python representation of DECIMAL64 fields in messages and batches:
+            'float' - float, nearest double value (default);
+            'raw' - int, 64-bit DFP encoding of value (int64 columns in batches);
+            'fixed' - int, value multiplied by 10^scale and rounded half to even (int64 columns in batches),
+                infinities and NaNs are returned as None;
+            'decimal' - decimal.Decimal with exact value.
+
+        Args:
+            mode (str): 'float', 'raw', 'fixed' or 'decimal'.
+            scale (int): number of decimal digits of fixed-point values, in range [-18, 18].
+            fieldScales (dict[str, int]): scales of fields, which differ from default scale.
+        '''
+        self.__setDecimalMode(mode, scale)
+        if fieldScales is not None:
+            for field, fieldScale in fieldScales.items():
+                self.__setDecimalScale(field, fieldScale)
+
+    def setTypedArrays(self, typed: bool) -> None:
+        '''Enables decoding of arrays of numeric elements (integers, floats, decimals, timestamps, booleans)
+        to typed memoryviews filled in one pass instead of lists of python objects.
+        Elements are copied into buffer of memoryview once, numpy.asarray() shares this buffer. Null elements of float and decimal arrays are NaN,
+        integer and boolean arrays with null elements are still returned as lists with None.
+
+        Args:
+            typed (bool): True to decode typed arrays, False to decode lists.
+        '''
+        self.__setTypedArrays(typed)
+
+    def setBinaryViews(self, views: bool) -> None:
+        '''Enables decoding of BINARY fields to read-only memoryviews instead of bytes.
+        Every value is a read-only view over its own buffer, which the value is copied into,
+        so memoryviews stay valid after next().
+
+        Args:
+            views (bool): True to decode memoryviews, False to decode bytes.
+        '''
+        self.__setBinaryViews(views)
+
     def isAtEnd(self) -> bool:
         '''Returns true if the last call to next() returned false. Returns false if next() has not been called yet.
         This method is legal to call any number of times at any point in the cursor's lifecycle.
@@ -209,6 +351,42 @@ public:
 	%rename(__getMessage) getMessage;
 	PyObject * getMessage();
 
+	%rename(__iterator) iterator;
+	PyObject * iterator(PyObject *owner);
+
+	%rename(__nextBatch) nextBatch;
+	PyObject * nextBatch(int32_t max_messages);
+
+	%rename(__nextArrowBatch) nextArrowBatch;
+	PyObject * nextArrowBatch(int32_t max_messages);
+
+	%rename(__readColumns) readColumns;
+	PyObject * readColumns(const std::vector<std::string> *fields);
+
+	%rename(__setFields) setFields;
+	void setFields(const std::vector<std::string> *fields);
+
+	%rename(__setLazyMessages) setLazyMessages;
+	void setLazyMessages(bool lazy);
+
+	%rename(__setTypedMessages) setTypedMessages;
+	void setTypedMessages(bool typed);
+
+	%rename(__setPrefetch) setPrefetch;
+	void setPrefetch(int32_t depth, int32_t batch_size);
+
+	%rename(__setDecimalMode) setDecimalMode;
+	void setDecimalMode(const std::string &mode, int32_t scale);
+
+	%rename(__setDecimalScale) setDecimalScale;
+	void setDecimalScale(const std::string &field, int32_t scale);
+
+	%rename(__setTypedArrays) setTypedArrays;
+	void setTypedArrays(bool typed);
+
+	%rename(__setBinaryViews) setBinaryViews;
+	void setBinaryViews(bool views);
+
     %rename(__isAtEnd) isAtEnd;
 	bool isAtEnd() const;
 
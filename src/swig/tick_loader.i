@@ -26,13 +26,102 @@ public:
             message (InstrumentMessage): A temporary buffer with the message.
                 By convention, the message is only valid for the duration of this call.
         '''
-        return self.__send(message)
+        self.__bindFastMethods()
+        return self.send(message)
+
+    def sendBatch(self, messages: 'list[InstrumentMessage]') -> int:
+        '''Sends list of messages in one call. Messages are sent in order, if some message
+        can't be sent, previous messages of the batch are already sent.
+
+        Args:
+            messages (list[InstrumentMessage]): messages to send.
+
+        Returns:
+            int: number of sent messages.
+        '''
+        self.__bindFastMethods()
+        return self.sendBatch(messages)
+
+    def sendColumns(self, typeName: str, symbols, timestamps, columns: dict) -> int:
+        '''Sends messages of one type, which fields are given by columns of values.
+        Numeric columns (numpy arrays, array.array, memoryview) are read in place without
+        creating python objects, other columns are read as sequences. NaN values are sent as nulls.
+        Fields, which are not in columns, are sent as nulls.
+
+        ```
+        loader.sendColumns('deltix.timebase.api.messages.BarMessage', 'AAPL',
+            df.index.values.view('int64'),
+            {'open': df['open'].values, 'close': df['close'].values})
+        ```
+
+        Args:
+            typeName (str): name of type of messages.
+            symbols (str or list[str]): symbol of all messages, or symbol of every message.
+            timestamps: timestamps of messages in nanoseconds, as InstrumentMessage.timestamp.
+            columns (dict): values of fields by field names, every column has the same length as timestamps.
+
+        Returns:
+            int: number of sent messages.
+        '''
+        return self.__sendColumns(typeName, symbols, timestamps, columns)
+
+    def setWorkers(self, workers: int, options: LoadingOptions) -> None:
+        '''Sets number of loaders, which encode and send messages of sendColumns in parallel threads.
+        Additional loaders of the stream are created with given options. Symbols are distributed
+        between loaders by hash, messages of every symbol are sent by one loader in order of rows.
+        Messages of send and sendBatch are sent by the first loader, so don't send messages
+        of the same symbol by these methods and sendColumns. Instrument ids are not supported as symbols.
+        Parallel sendColumns is not atomic: if one loader fails, rows already sent by other loaders
+        stay sent, and the error reports sent/total rows of every loader.
+
+        ```
+        loader = stream.createLoader(options)
+        loader.setWorkers(8, options)
+        loader.sendColumns('deltix.timebase.api.messages.BarMessage', df['symbol'].values,
+            df.index.values.view('int64'), {'close': df['close'].values})
+        ```
+
+        Args:
+            workers (int): number of loaders, 1 to send messages by this loader only.
+            options (LoadingOptions): options of additional loaders.
+        '''
+        return self.__setWorkers(workers, options)
+
+    def setAsync(self, queueSize: int, dropOnOverflow: bool = False, flushPeriodMs: int = 1000) -> None:
+        '''Makes send and sendBatch asynchronous: field values of messages are put to queue,
+        background thread encodes and sends them, and flushes loader periodically.
+        Errors of background thread are raised by the next send, flush or close. Message objects
+        can be reused after send, but values of their fields (lists) should not be modified.
+        sendColumns is not supported by asynchronous loader.
+
+        ```
+        loader.setAsync(100000, dropOnOverflow=True)
+        loader.send(message)  # returns without waiting for server
+        print(loader.nDroppedMessages())
+        ```
+
+        Args:
+            queueSize (int): max number of queued messages, 0 to send messages synchronously.
+            dropOnOverflow (bool): drop messages, when queue is full, instead of waiting for free space.
+            flushPeriodMs (int): period of flushes in milliseconds, 0 to flush only by flush.
+        '''
+        return self.__setAsync(queueSize, dropOnOverflow, flushPeriodMs)
+
+    def nDroppedMessages(self) -> int:
+        '''Returns number of messages, which are dropped by asynchronous loader on overflow of queue'''
+        return self.__nDroppedMessages()
 
     def flush(self) -> None:
         '''Flushes all buffered messages by sending them to server.
         Note that calling 'send' method not guaranty that all messages will be delivered and stored to server.
         '''
-        return self.__flush()
+        self.__bindFastMethods()
+        return self.flush()
+
+    def __bindFastMethods(self):
+        # native send, sendBatch and flush shadow these shims in the loader object,
+        # so next calls go directly to C++ without SWIG argument conversion
+        self.__dict__.update(self.__fastMethods(self))
 
     def close(self) -> None:
         '''Flushes and closes the loader'''
@@ -111,9 +200,27 @@ public:
     %rename(__send) send;
 	void send(PyObject *message);
 
+    %rename(__sendBatch) sendBatch;
+	size_t sendBatch(PyObject *messages);
+
+    %rename(__sendColumns) sendColumns;
+	size_t sendColumns(const std::string &type_name, PyObject *symbols, PyObject *timestamps, PyObject *columns);
+
+    %rename(__setWorkers) setWorkers;
+    void setWorkers(size_t workers, const DxApi::LoadingOptions &options);
+
+    %rename(__setAsync) setAsync;
+    void setAsync(size_t queue_size, bool drop_on_overflow, int32_t flush_period_ms);
+
+    %rename(__nDroppedMessages) nDroppedMessages;
+    size_t nDroppedMessages();
+
 	%rename(__flush) flush;
 	void flush();
 
+	%rename(__fastMethods) fastMethods;
+	PyObject * fastMethods(PyObject *owner);
+
 	%rename(__close) close;
 	void close();
 
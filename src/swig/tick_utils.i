@@ -3,37 +3,34 @@
 
 from collections import defaultdict
 
-def stream_to_dict(db, stream, fields=None, ts_from=0, ts_to=JAVA_LONG_MAX_VALUE):
+def __readStreamColumns(db, stream, fields, ts_from, ts_to):
     if ts_to > JAVA_LONG_MAX_VALUE:
         ts_to = JAVA_LONG_MAX_VALUE
     if not db.isOpen():
         raise Exception('Database is not opened.')
     options = SelectionOptions()
     options.to = ts_to
-    messages = []
-    table = defaultdict(list)
     with stream.trySelect(ts_from, options, None, None) as cursor:
-        counter = 0
-        while cursor.next():
-            message = vars(cursor.getMessage())
-            messages.append(message)
-            if fields is None:
-                def to_write(x):
-                    return True
-            else:
-                def to_write(x):
-                    return x in fields
-            for key in table.keys():
-                if key in message:
-                    table[key].append(message[key])
-                    del message[key]
-                else:
-                    table[key].append(None)
-            for key in message:
-                if to_write(key):
-                    table[key] = [None] * counter
-                    table[key].append(message[key])
-            counter += 1
+        return cursor.readColumns(None if fields is None else list(fields))
+
+def stream_to_columns(db, stream, fields=None, ts_from=0, ts_to=JAVA_LONG_MAX_VALUE) -> dict:
+    '''Reads messages of stream into dictionary of columns ready for pandas.DataFrame (see MessageBatch.toDict).
+    Messages are decoded natively into typed columns, fields absent in message (polymorphic streams) are null.
+
+    Args:
+        db (TickDb): opened database.
+        stream (TickStream): stream to read.
+        fields (list[str]): names of fields to read, all fields are read if None.
+        ts_from (int): start timestamp in millis.
+        ts_to (int): end timestamp in millis.
+    '''
+    return __readStreamColumns(db, stream, fields, ts_from, ts_to).toDict()
+
+def stream_to_dict(db, stream, fields=None, ts_from=0, ts_to=JAVA_LONG_MAX_VALUE):
+    batch = __readStreamColumns(db, stream, fields, ts_from, ts_to)
+    table = defaultdict(list)
+    for name in batch.keys():
+        table[name] = batch.decode(name)
     return table
 
 
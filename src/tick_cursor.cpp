@@ -2,6 +2,11 @@
 
 #include "python_common.h"
 #include "codecs/message_codec.h"
+#include "codecs/codec_cache.h"
+#include "codecs/column_batch.h"
+#include "codecs/arrow_export.h"
+#include "lazy_message.h"
+#include "cursor_iterator.h"
 
 namespace TbApiImpl {
 namespace Python {
@@ -11,31 +16,75 @@ enum CursorState {
     READING,
     END
 };
+
+// max number of lazy messages in one chunk
+static const size_t LAZY_CHUNK_SIZE = 1024;
+
+// max number of batches read ahead by prefetching thread
+static const int32_t MAX_PREFETCH_DEPTH = 64;
+
+// header columns of batch, NULL if column is not selected
+struct HeaderColumns {
+    HeaderColumns(ColumnBatch &batch) :
+        timestamp(batch.getColumn(TIMESTAMP_PROPERTY, INT64_COLUMN)),
+        symbol(batch.getColumn(SYMBOL_PROPERTY, CATEGORY_COLUMN)),
+        type_id(batch.getColumn(TYPE_ID_PROPERTY, INT64_COLUMN)),
+        type_name(batch.getColumn(TYPE_NAME_PROPERTY, CATEGORY_COLUMN))
+    {
+        // timestamps of messages are in nanoseconds
+        if (timestamp != NULL)
+            timestamp->setArrowFormat("tsn:");
+    }
+
+    Column *timestamp;
+    Column *symbol;
+    Column *type_id;
+    Column *type_name;
+};
+
+// header is decoded regardless of selected fields, like header of message objects
+static void selectHeaderAndFields(ColumnBatch &batch, const std::vector<std::string> &fields) {
+    std::vector<std::string> columns = { TIMESTAMP_PROPERTY, SYMBOL_PROPERTY, TYPE_ID_PROPERTY, TYPE_NAME_PROPERTY };
+    columns.insert(columns.end(), fields.begin(), fields.end());
+    batch.setFields(columns);
+}
     
-TickCursor::TickCursor(DxApi::TickCursor *cursor) {
+TickCursor::TickCursor(DxApi::TickCursor *cursor) : prefetch_stop_(false) {
     cursor_ = std::unique_ptr<DxApi::TickCursor>(cursor);
 }
 
 TickCursor::~TickCursor() {
+    stopPrefetch();
+
     Py_DECREF(TYPE_ID_PROPERTY1);
     Py_DECREF(TYPE_NAME_PROPERTY1);
     Py_DECREF(INSTRUMENT_ID_PROPERTY1);
     Py_DECREF(SYMBOL_PROPERTY1);
     Py_DECREF(TIMESTAMP_PROPERTY1);
 
+    clearHeaderCache();
+    clearLazyMessages();
+
     if (cursor_ == nullptr)
         return;
 
     if (!cursor_->isClosed())
         cursor_->close();
+    clearMessageObjects();
+}
+
+void TickCursor::clearMessageObjects() {
     for (int i = 0; i < message_objects_.size(); ++i) {
         if (message_objects_[i] != NULL) {
             Py_DECREF(message_objects_[i]);
         }
     }
+    message_objects_.clear();
 }
 
 const char * TickCursor::getCurrentStreamKey() {
+    checkNotPrefetching("getCurrentStreamKey");
+
     if (instrument_message_ == nullptr)
         return NULL;
 
@@ -51,6 +100,8 @@ bool TickCursor::next() {
     if (cursor_ == nullptr)
         THROW("Cursor is null.");
 
+    checkNotPrefetching("next");
+
     if (cursor_->isClosed())
         THROW("Cursor is closed.");
 
@@ -60,7 +111,7 @@ bool TickCursor::next() {
     if (instrument_message_ == nullptr)
         instrument_message_ = std::shared_ptr<DxApi::InstrumentMessage>(new DxApi::InstrumentMessage());
 
-    bool has_next = cursor_->next(instrument_message_.get());
+    bool has_next = fetchNext();
     if (has_next)
         decodeCurrentMessage();
 
@@ -71,6 +122,8 @@ NextResult TickCursor::nextIfAvailable() {
     if (cursor_ == nullptr)
         THROW("Cursor is null.");
 
+    checkNotPrefetching("nextIfAvailable");
+
     if (cursor_->isClosed())
         THROW("Cursor is closed.");
 
@@ -80,7 +133,12 @@ NextResult TickCursor::nextIfAvailable() {
     if (instrument_message_ == nullptr)
         instrument_message_ = std::shared_ptr<DxApi::InstrumentMessage>(new DxApi::InstrumentMessage());
 
-    bool has_next = cursor_->nextIfAvailable(instrument_message_.get());
+    bool has_next;
+    {
+        PythonGILReleaseHolder release_gil;
+        has_next = cursor_->nextIfAvailable(instrument_message_.get());
+    }
+
     if (has_next) {
         decodeCurrentMessage();
         return NextResult::OK;
@@ -92,9 +150,14 @@ NextResult TickCursor::nextIfAvailable() {
 }
 
 PyObject * TickCursor::getMessage() {
+    checkNotPrefetching("getMessage");
+
     if (instrument_message_ == nullptr)
         Py_RETURN_NONE;
 
+    if (lazy_messages_)
+        return getLazyMessage();
+
     if (instrument_message_->typeId >= message_objects_.size())
         Py_RETURN_NONE;
 
@@ -103,28 +166,270 @@ PyObject * TickCursor::getMessage() {
     return message_object;
 }
 
-void TickCursor::decodeCurrentMessage() {
-    uint32_t type_id = instrument_message_->typeId;
+PyObject * TickCursor::iterator(PyObject *owner) {
+    return newCursorIterator(this, owner);
+}
+
+PyObject * TickCursor::nextBatch(int32_t max_messages) {
+    if (cursor_ == nullptr)
+        THROW("Cursor is null.");
+
+    if (isClosed())
+        THROW("Cursor is closed.");
+
+    if (max_messages <= 0)
+        THROW_EXCEPTION("Invalid size of batch: %d.", max_messages);
+
+    if (prefetch_depth_ > 0) {
+        column_batch_ = takePrefetchedBatch();
+        return column_batch_->toPython();
+    }
+
+    if (column_batch_ == nullptr) {
+        column_batch_ = std::unique_ptr<ColumnBatch>(new ColumnBatch());
+        selectFields(*column_batch_);
+    }
+    column_batch_->clear();
+
+    readBatch(*column_batch_, (size_t) max_messages);
+    return column_batch_->toPython();
+}
+
+PyObject * TickCursor::nextArrowBatch(int32_t max_messages) {
+    if (cursor_ == nullptr)
+        THROW("Cursor is null.");
+
+    if (isClosed())
+        THROW("Cursor is closed.");
+
+    if (max_messages <= 0)
+        THROW_EXCEPTION("Invalid size of batch: %d.", max_messages);
+
+    if (prefetch_depth_ > 0)
+        column_batch_ = takePrefetchedBatch();
+
+    if (column_batch_ == nullptr) {
+        column_batch_ = std::unique_ptr<ColumnBatch>(new ColumnBatch());
+        selectFields(*column_batch_);
+    }
+
+    if (prefetch_depth_ == 0) {
+        column_batch_->clear();
+        readBatch(*column_batch_, (size_t) max_messages);
+    }
+
+    size_t size = column_batch_->size();
+    PythonRefHolder capsules(exportArrowBatch(*column_batch_));
+    column_batch_->clear();
+
+    return Py_BuildValue("(nO)", (Py_ssize_t) size, capsules.getReference());
+}
+
+PyObject * TickCursor::readColumns(const std::vector<std::string> *fields) {
+    if (cursor_ == nullptr)
+        THROW("Cursor is null.");
+
+    checkNotPrefetching("readColumns");
+
+    if (cursor_->isClosed())
+        THROW("Cursor is closed.");
+
+    ColumnBatch batch;
+    if (fields != NULL)
+        selectHeaderAndFields(batch, *fields);
+    else
+        selectFields(batch);
+
+    readBatch(batch, SIZE_MAX);
+    return batch.toPython();
+}
+
+void TickCursor::readBatch(ColumnBatch &batch, size_t max_messages) {
+    if (instrument_message_ == nullptr)
+        instrument_message_ = std::shared_ptr<DxApi::InstrumentMessage>(new DxApi::InstrumentMessage());
+
+    HeaderColumns header(batch);
+    while (batch.size() < max_messages) {
+        if (cursor_->isAtEnd() || prefetch_stop_)
+            break;
+
+        if (!fetchNext())
+            break;
+
+        decodeCurrentMessage(*instrument_message_, batch, header);
+    }
+}
+
+void TickCursor::prefetchBatch(ColumnBatch &batch, size_t max_messages) {
+    // prefetching thread doesn't hold GIL, which is taken only to create decoders and python objects of fields
+    HeaderColumns header(batch);
+    while (batch.size() < max_messages) {
+        if (cursor_->isAtEnd() || prefetch_stop_)
+            break;
+
+        if (!cursor_->next(&prefetch_message_))
+            break;
+
+        uint32_t type_id = prefetch_message_.typeId;
+        MessageCodec *message_decoder = type_id < message_decoders_.size() ? message_decoders_[type_id].get() : NULL;
+        if (message_decoder != NULL && !message_decoder->decodesObjects(batch)) {
+            decodeCurrentMessage(prefetch_message_, batch, header);
+        } else {
+            PythonGILLockHolder gil;
+            decodeCurrentMessage(prefetch_message_, batch, header);
+        }
+    }
+}
+
+void TickCursor::setFields(const std::vector<std::string> *fields) {
+    stopPrefetch();
+
+    if (fields == NULL)
+        fields_.reset();
+    else
+        fields_ = std::unique_ptr<std::unordered_set<std::string>>(
+            new std::unordered_set<std::string>(fields->begin(), fields->end()));
+
+    for (auto &message_decoder : message_decoders_) {
+        if (message_decoder != nullptr)
+            message_decoder->setFields(fields_.get());
+    }
+
+    // reused message objects, batch columns and lazy chunks keep previously selected fields
+    clearMessageObjects();
+    clearLazyMessages();
+    column_batch_.reset();
+}
+
+void TickCursor::setDecimalMode(const std::string &mode, int32_t scale) {
+    DecimalMode decimal_mode;
+    if (mode == "float")
+        decimal_mode = DECIMAL_FLOAT;
+    else if (mode == "raw")
+        decimal_mode = DECIMAL_RAW;
+    else if (mode == "fixed")
+        decimal_mode = DECIMAL_FIXED;
+    else if (mode == "decimal")
+        decimal_mode = DECIMAL_OBJECT;
+    else
+        THROW_EXCEPTION("Unknown decimal mode: '%s'. Mode should be 'float', 'raw', 'fixed' or 'decimal'.", mode.c_str());
+
+    if (scale < -MAX_DECIMAL_SCALE || scale > MAX_DECIMAL_SCALE)
+        THROW_EXCEPTION("Invalid decimal scale: %d. Scale should be in range [%d, %d].",
+            scale, -MAX_DECIMAL_SCALE, MAX_DECIMAL_SCALE);
+
+    stopPrefetch();
+    decimal_options_.mode = decimal_mode;
+    decimal_options_.scale = scale;
+    decimal_options_.field_scales.clear();
+    applyDecimalOptions();
+}
+
+void TickCursor::setDecimalScale(const std::string &field, int32_t scale) {
+    if (scale < -MAX_DECIMAL_SCALE || scale > MAX_DECIMAL_SCALE)
+        THROW_EXCEPTION("Invalid decimal scale of field '%s': %d. Scale should be in range [%d, %d].",
+            field.c_str(), scale, -MAX_DECIMAL_SCALE, MAX_DECIMAL_SCALE);
+
+    stopPrefetch();
+    decimal_options_.field_scales[field] = scale;
+    applyDecimalOptions();
+}
+
+void TickCursor::setTypedArrays(bool typed) {
+    stopPrefetch();
+    typed_arrays_ = typed;
+    for (auto &message_decoder : message_decoders_) {
+        if (message_decoder != nullptr)
+            message_decoder->setTypedArrays(typed);
+    }
+
+    clearLazyMessages();
+    column_batch_.reset();
+}
+
+void TickCursor::setBinaryViews(bool views) {
+    stopPrefetch();
+    binary_views_ = views;
+    for (auto &message_decoder : message_decoders_) {
+        if (message_decoder != nullptr)
+            message_decoder->setBinaryViews(views);
+    }
+
+    clearLazyMessages();
+    column_batch_.reset();
+}
+
+void TickCursor::applyDecimalOptions() {
+    for (auto &message_decoder : message_decoders_) {
+        if (message_decoder != nullptr)
+            message_decoder->setDecimalOptions(decimal_options_);
+    }
+
+    // types of batch columns depend on decimal mode
+    clearLazyMessages();
+    column_batch_.reset();
+}
+
+void TickCursor::selectFields(ColumnBatch &batch) {
+    if (fields_ == nullptr)
+        return;
+
+    selectHeaderAndFields(batch, std::vector<std::string>(fields_->begin(), fields_->end()));
+}
+
+bool TickCursor::fetchNext() {
+    // other python threads may run while cursor waits for data, decoding requires GIL
+    PythonGILReleaseHolder release_gil;
+    return cursor_->next(instrument_message_.get());
+}
+
+std::shared_ptr<MessageCodec> TickCursor::getMessageDecoder(uint32_t type_id) {
     while (message_decoders_.size() <= type_id)
         message_decoders_.push_back(nullptr);
 
-    while (message_objects_.size() <= type_id)
-        message_objects_.push_back(NULL);
-
     std::shared_ptr<MessageCodec> message_decoder = message_decoders_[type_id];
     if (message_decoder == nullptr) {
         const std::string *schema = cursor_->getMessageSchema(type_id);
 
-        std::vector<Schema::TickDbClassDescriptor> descriptors =
-            Schema::TickDbClassDescriptor::parseDescriptors(*schema, true);
-
-        message_decoder = std::shared_ptr<MessageCodec>(new MessageCodec(&tbapi_module_, descriptors, 0));
+        // schema of message type describes its class first
+        CodecCache &codec_cache = CodecCache::instance();
+        message_decoder = codec_cache.acquireCodec(codec_cache.getSchema(*schema), 0);
+        if (fields_ != nullptr)
+            message_decoder->setFields(fields_.get());
+        if (decimal_options_.mode != DECIMAL_FLOAT)
+            message_decoder->setDecimalOptions(decimal_options_);
+        if (typed_arrays_)
+            message_decoder->setTypedArrays(true);
+        if (binary_views_)
+            message_decoder->setBinaryViews(true);
         message_decoders_[type_id] = message_decoder;
     }
 
+    return message_decoder;
+}
+
+void TickCursor::decodeCurrentMessage() {
+    if (lazy_messages_) {
+        Py_XDECREF(lazy_message_);
+        lazy_message_ = NULL;
+        lazy_message_decoded_ = false;
+        decodeLazyMessage();
+        lazy_message_decoded_ = true;
+        return;
+    }
+
+    uint32_t type_id = instrument_message_->typeId;
+    std::shared_ptr<MessageCodec> message_decoder = getMessageDecoder(type_id);
+
+    while (message_objects_.size() <= type_id)
+        message_objects_.push_back(NULL);
+
     PyObject *message_object = message_objects_[type_id];
     if (message_object == NULL) {
-        message_object = tbapi_module_.newInstrumentMessageObject();
+        if (typed_messages_)
+            message_object = message_decoder->newTypedMessage();
+        else
+            message_object = tbapi_module_.newInstrumentMessageObject();
         //message_object = PyDict_New();
         if (message_object == NULL)
             THROW_EXCEPTION("Can't create object of class '%32s'", MESSAGE_OBJECT_CLASS_NAME.c_str());
@@ -136,47 +441,254 @@ void TickCursor::decodeCurrentMessage() {
     message_decoder->decode(message_object, cursor_->getReader());
 }
 
+void TickCursor::setLazyMessages(bool lazy) {
+    checkNotPrefetching("setLazyMessages");
+
+    clearLazyMessages();
+    lazy_messages_ = lazy;
+}
+
+void TickCursor::setTypedMessages(bool typed) {
+    checkNotPrefetching("setTypedMessages");
+
+    clearMessageObjects();
+    typed_messages_ = typed;
+}
+
+void TickCursor::decodeLazyMessage() {
+    uint32_t type_id = instrument_message_->typeId;
+    while (lazy_chunks_.size() <= type_id) {
+        lazy_chunks_.push_back(NULL);
+        lazy_accessors_.push_back(NULL);
+    }
+
+    // messages keep reference to accessor of their chunk, so full chunk is replaced instead of cleared
+    LazyMessageChunk *chunk = lazy_chunks_[type_id];
+    if (chunk == NULL || chunk->getBatch().size() >= LAZY_CHUNK_SIZE) {
+        Py_XDECREF(lazy_accessors_[type_id]);
+        lazy_accessors_[type_id] = LazyMessageChunk::newAccessor(&chunk);
+        lazy_chunks_[type_id] = chunk;
+        selectFields(chunk->getBatch());
+    }
+
+    // header is decoded into columns too, python objects are created by getMessage() and on access to fields
+    ColumnBatch &batch = chunk->getBatch();
+    decodeCurrentMessage(*instrument_message_, batch, HeaderColumns(batch));
+}
+
+PyObject * TickCursor::getLazyMessage() {
+    if (lazy_message_ != NULL) {
+        Py_INCREF(lazy_message_);
+        return lazy_message_;
+    }
+
+    // message was read before lazy mode was enabled or its decoding failed (row was rolled back)
+    if (!lazy_message_decoded_)
+        Py_RETURN_NONE;
+
+    uint32_t type_id = instrument_message_->typeId;
+
+    size_t row = lazy_chunks_[type_id]->getBatch().size() - 1;
+    lazy_message_ = tbapi_module_.newLazyMessageObject(lazy_accessors_[type_id], row);
+    if (lazy_message_ == NULL)
+        THROW_EXCEPTION("Can't create object of class '%32s'", LAZY_MESSAGE_OBJECT_CLASS_NAME.c_str());
+
+    Py_INCREF(lazy_message_);
+    return lazy_message_;
+}
+
+void TickCursor::clearLazyMessages() {
+    Py_XDECREF(lazy_message_);
+    lazy_message_ = NULL;
+    lazy_message_decoded_ = false;
+
+    for (PyObject *accessor : lazy_accessors_)
+        Py_XDECREF(accessor);
+    lazy_accessors_.clear();
+    lazy_chunks_.clear();
+}
+
+void TickCursor::decodeCurrentMessage(const DxApi::InstrumentMessage &message, ColumnBatch &batch, const HeaderColumns &header) {
+    uint32_t type_id = message.typeId;
+    std::shared_ptr<MessageCodec> message_decoder = getMessageDecoder(type_id);
+
+    try {
+        decodeMessageColumns(message, *message_decoder, batch, header);
+    } catch (...) {
+        // columns of failed message are rolled back, so they stay aligned with rows of batch,
+        // GIL is taken, since rolled back values may be python objects (prefetching thread doesn't hold it)
+        PythonGILLockHolder gil;
+        batch.discardRow();
+        throw;
+    }
+
+    batch.endRow();
+}
+
+void TickCursor::decodeMessageColumns(const DxApi::InstrumentMessage &message, MessageCodec &message_decoder,
+    ColumnBatch &batch, const HeaderColumns &header)
+{
+    uint32_t type_id = message.typeId;
+    if (header.timestamp != NULL)
+        header.timestamp->appendInt64(message.timestamp);
+
+    Column *symbol_column = header.symbol;
+    if (symbol_column != NULL) {
+        int32_t entity_id = message.entityId;
+        if (!symbol_column->hasCategory(entity_id)) {
+            const std::string *symbol_string = cursor_->getInstrument(entity_id);
+            if (symbol_string != NULL)
+                symbol_column->setCategory(entity_id, *symbol_string);
+        }
+        if (symbol_column->hasCategory(entity_id))
+            symbol_column->appendCategory(entity_id);
+        else
+            symbol_column->appendNull();
+    }
+
+    if (header.type_id != NULL)
+        header.type_id->appendInt64(type_id);
+
+    Column *type_name_column = header.type_name;
+    if (type_name_column != NULL) {
+        if (!type_name_column->hasCategory(type_id)) {
+            const std::string *type_name_string = cursor_->getMessageTypeName(type_id);
+            if (type_name_string != NULL)
+                type_name_column->setCategory(type_id, *type_name_string);
+        }
+        if (type_name_column->hasCategory(type_id))
+            type_name_column->appendCategory(type_id);
+        else
+            type_name_column->appendNull();
+    }
+
+    message_decoder.decode(cursor_->getReader(), batch);
+}
+
 void TickCursor::decodeHeader(PyObject * message_object) {
     //decode timestamp
     PythonRefHolder ts_obj(PyLong_FromLongLong(instrument_message_->timestamp));
     PyObject_SetAttr(message_object, TIMESTAMP_PROPERTY1, ts_obj.getReference());
 
     //decode symbol
-    const std::string *symbol_string = cursor_->getInstrument(instrument_message_->entityId);
-    if (symbol_string == NULL) {
-        PyObject_SetAttr(message_object, SYMBOL_PROPERTY1, Py_None);
-    } else {
-        PythonRefHolder symbol_obj(PyUnicode_FromString(symbol_string->c_str()));
-        PyObject_SetAttr(message_object, SYMBOL_PROPERTY1, symbol_obj.getReference());
-    }
+    PythonRefHolder symbol_obj(getSymbolObject(instrument_message_->entityId));
+    PyObject_SetAttr(message_object, SYMBOL_PROPERTY1, symbol_obj.getReference());
 
     //decode type id
-    PythonRefHolder type_id_obj(PyLong_FromLong(instrument_message_->typeId));
+    PythonRefHolder type_id_obj(getTypeIdObject(instrument_message_->typeId));
     PyObject_SetAttr(message_object, TYPE_ID_PROPERTY1, type_id_obj.getReference());
 
     //decode type name
-    const std::string *type_name_string = cursor_->getMessageTypeName(instrument_message_->typeId);
-    if (type_name_string == NULL) {
-        PyObject_SetAttr(message_object, TYPE_NAME_PROPERTY1, Py_None);
-    } else {
-        PythonRefHolder type_name_obj(PyUnicode_FromString(type_name_string->c_str()));
-        PyObject_SetAttr(message_object, TYPE_NAME_PROPERTY1, type_name_obj.getReference());
-    }
+    PythonRefHolder type_name_obj(getTypeNameObject(instrument_message_->typeId));
+    PyObject_SetAttr(message_object, TYPE_NAME_PROPERTY1, type_name_obj.getReference());
+}
+
+// returns new reference to cached object or NULL
+static PyObject * findCachedObject(const std::vector<PyObject *> &cache, int64_t index) {
+    if (index < 0 || index >= (int64_t) cache.size())
+        return NULL;
+
+    PyObject *object = cache[index];
+    Py_XINCREF(object);
+    return object;
+}
+
+// stores object in cache, returns object
+static PyObject * cacheObject(std::vector<PyObject *> &cache, int64_t index, PyObject *object) {
+    if (object == NULL)
+        THROW("Can't create object of message header.");
+
+    if (index < 0)
+        return object;
+
+    if (index >= (int64_t) cache.size())
+        cache.resize(index + 1, NULL);
+
+    Py_XDECREF(cache[index]);
+    Py_INCREF(object);
+    cache[index] = object;
+    return object;
+}
+
+static void clearCachedObjects(std::vector<PyObject *> &cache) {
+    for (PyObject *object : cache)
+        Py_XDECREF(object);
+    cache.clear();
+}
+
+static PyObject * newInternedString(const std::string &value) {
+    PyObject *object = PyUnicode_FromString(value.c_str());
+    if (object != NULL)
+        PyUnicode_InternInPlace(&object);
+    return object;
+}
+
+PyObject * TickCursor::getSymbolObject(int32_t entity_id) {
+    PyObject *symbol_obj = findCachedObject(symbol_objects_, entity_id);
+    if (symbol_obj != NULL)
+        return symbol_obj;
+
+    const std::string *symbol_string = cursor_->getInstrument(entity_id);
+    if (symbol_string == NULL)
+        Py_RETURN_NONE;
+
+    return cacheObject(symbol_objects_, entity_id, newInternedString(*symbol_string));
+}
+
+PyObject * TickCursor::getTypeNameObject(uint32_t type_id) {
+    PyObject *type_name_obj = findCachedObject(type_name_objects_, type_id);
+    if (type_name_obj != NULL)
+        return type_name_obj;
+
+    const std::string *type_name_string = cursor_->getMessageTypeName(type_id);
+    if (type_name_string == NULL)
+        Py_RETURN_NONE;
+
+    return cacheObject(type_name_objects_, type_id, newInternedString(*type_name_string));
+}
+
+PyObject * TickCursor::getTypeIdObject(uint32_t type_id) {
+    PyObject *type_id_obj = findCachedObject(type_id_objects_, type_id);
+    if (type_id_obj != NULL)
+        return type_id_obj;
+
+    return cacheObject(type_id_objects_, type_id, PyLong_FromLong(type_id));
+}
+
+void TickCursor::clearHeaderCache() {
+    clearCachedObjects(symbol_objects_);
+    clearCachedObjects(type_name_objects_);
+    clearCachedObjects(type_id_objects_);
+
+    // categories of batch columns are cached by the same ids
+    column_batch_.reset();
 }
 
 bool TickCursor::isAtEnd() const {
+    if (prefetch_thread_.joinable()) {
+        // cursor is owned by prefetching thread
+        std::lock_guard<std::mutex> lock(const_cast<std::mutex &>(prefetch_lock_));
+        return prefetch_done_ && prefetched_batches_.empty() && prefetch_error_.empty();
+    }
+
     return cursor_->isAtEnd();
 }
 
 bool TickCursor::isClosed() const {
+    // cursor is owned by prefetching thread, it's closed only after prefetching is stopped
+    if (prefetch_thread_.joinable())
+        return false;
+
     return cursor_->isClosed();
 }
 
 void TickCursor::close() {
+    stopPrefetch();
     cursor_->close();
 }
 
 void TickCursor::reset(DxApi::TimestampMs dt) {
+    stopPrefetch();
     cursor_->reset(dt);
 }
 
@@ -184,97 +696,265 @@ void TickCursor::reset(DxApi::TimestampMs dt, const std::vector<std::string> *en
     if (entities == NULL)
         return;
 
+    stopPrefetch();
     cursor_->reset(dt, *entities);
+    clearHeaderCache();
 }
 
 void TickCursor::subscribeToAllEntities() {
+    stopPrefetch();
     cursor_->subscribeToAllEntities();
+    clearHeaderCache();
 }
 
 void TickCursor::clearAllEntities() {
+    stopPrefetch();
     cursor_->clearAllEntities();
+    clearHeaderCache();
 }
 
 void TickCursor::addEntities(const std::vector<std::string> *entities) {
     if (entities == NULL)
         return;
 
+    stopPrefetch();
     cursor_->addEntities(*entities);
+    clearHeaderCache();
 }
 
 void TickCursor::addEntity(const std::string &entity) {
+    stopPrefetch();
     cursor_->addEntity(entity);
+    clearHeaderCache();
 }
 
 void TickCursor::removeEntities(const std::vector<std::string> *entities) {
     if (entities == NULL)
         return;
 
+    stopPrefetch();
     cursor_->removeEntities(*entities);
+    clearHeaderCache();
 }
 
 void TickCursor::removeEntity(const std::string &entity) {
+    stopPrefetch();
     cursor_->removeEntity(entity);
+    clearHeaderCache();
 }
 
 void TickCursor::subscribeToAllTypes() {
+    stopPrefetch();
     cursor_->subscribeToAllTypes();
+    clearHeaderCache();
 }
 
 void TickCursor::addTypes(const std::vector<std::string> *types) {
     if (types == NULL)
         return;
 
+    stopPrefetch();
     cursor_->addTypes(*types);
+    clearHeaderCache();
 }
 
 void TickCursor::removeTypes(const std::vector<std::string> *types) {
     if (types == NULL)
         return;
 
+    stopPrefetch();
     cursor_->removeTypes(*types);
+    clearHeaderCache();
 }
 
 void TickCursor::setTypes(const std::vector<std::string> *types) {
     if (types == NULL)
         return;
 
+    stopPrefetch();
     cursor_->setTypes(*types);
+    clearHeaderCache();
 }
 
 void TickCursor::add(const std::vector<std::string> *types, const std::vector<std::string> * entities) {
     if (entities == NULL || types == NULL)
         return;
 
+    stopPrefetch();
     cursor_->add(*entities, *types);
+    clearHeaderCache();
 }
 
 void TickCursor::remove(const std::vector<std::string> *types, const std::vector<std::string> * entities) {
     if (entities == NULL || types == NULL)
         return;
 
+    stopPrefetch();
     cursor_->remove(*entities, *types);
+    clearHeaderCache();
 }
 
 void TickCursor::addStreams(const std::vector<DxApi::TickStream *> *streams) {
     if (streams == NULL)
         return;
 
+    stopPrefetch();
     cursor_->addStreams(*streams);
+    clearHeaderCache();
 }
 
 void TickCursor::removeStreams(const std::vector<DxApi::TickStream *> *streams) {
     if (streams == NULL)
         return;
 
+    stopPrefetch();
     cursor_->removeStreams(*streams);
+    clearHeaderCache();
 }
 
 void TickCursor::removeAllStreams() {
+    stopPrefetch();
     cursor_->removeAllStreams();
+    clearHeaderCache();
+}
+
+void TickCursor::setLive(bool live) {
+    live_ = live;
+}
+
+void TickCursor::setPrefetch(int32_t depth, int32_t batch_size) {
+    // prefetching thread waits for live data in next() and can't be interrupted, so it couldn't be stopped
+    if (depth > 0 && live_)
+        THROW("Prefetching is not available for live cursors.");
+
+    if (depth < 0 || depth > MAX_PREFETCH_DEPTH)
+        THROW_EXCEPTION("Invalid prefetch depth: %d. Depth should be in range [0, %d].", depth, MAX_PREFETCH_DEPTH);
+
+    if (depth > 0 && batch_size <= 0)
+        THROW_EXCEPTION("Invalid size of batch: %d.", batch_size);
+
+    stopPrefetch();
+    prefetch_depth_ = (size_t) depth;
+    prefetch_batch_size_ = (size_t) batch_size;
+}
+
+void TickCursor::checkNotPrefetching(const char *method) {
+    // prefetched rows are not served as message objects: the ring keeps only columns of batches
+    if (prefetch_depth_ > 0)
+        THROW_EXCEPTION("Method '%s' is not available, while batches are prefetched. "
+            "Use nextBatch() or disable prefetching.", method);
+}
+
+void TickCursor::startPrefetch() {
+    prefetch_stop_ = false;
+    prefetch_done_ = false;
+    prefetch_error_.clear();
+    prefetch_thread_ = std::thread(&TickCursor::prefetchBatches, this);
+}
+
+void TickCursor::stopPrefetch() {
+    if (!prefetch_thread_.joinable())
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(prefetch_lock_);
+        prefetch_stop_ = true;
+    }
+    prefetch_space_.notify_all();
+
+    {
+        // thread finishes current message, it may need GIL for decoding
+        PythonGILReleaseHolder release_gil;
+        prefetch_thread_.join();
+    }
+
+    prefetched_batches_.clear();
+    prefetch_stop_ = false;
+    prefetch_done_ = false;
+    prefetch_error_.clear();
+}
+
+void TickCursor::prefetchBatches() {
+    // thread state is kept by the thread, so GIL is taken for some messages without creating thread state
+    PythonGILLockHolder thread_state;
+    PythonGILReleaseHolder release_gil;
+
+    bool finished = false;
+    while (!finished) {
+        std::unique_ptr<ColumnBatch> batch(new ColumnBatch());
+        std::string error;
+        try {
+            selectFields(*batch);
+            prefetchBatch(*batch, prefetch_batch_size_);
+        } catch (const std::exception &e) {
+            error = e.what();
+        } catch (...) {
+            error = "Unknown error.";
+        }
+
+        finished = !error.empty() || batch->size() < prefetch_batch_size_;
+
+        {
+            std::unique_lock<std::mutex> lock(prefetch_lock_);
+            prefetch_space_.wait(lock, [this] {
+                return prefetch_stop_ || prefetched_batches_.size() < prefetch_depth_;
+            });
+            if (!prefetch_stop_) {
+                if (batch->size() > 0)
+                    prefetched_batches_.push_back(std::move(batch));
+
+                prefetch_error_ = error;
+                prefetch_done_ = finished;
+                prefetch_ready_.notify_all();
+            } else {
+                finished = true;
+            }
+        }
+
+        if (batch != nullptr) {
+            // dropped batch may keep python objects of fields
+            PythonGILLockHolder gil;
+            batch.reset();
+        }
+    }
+}
+
+std::unique_ptr<ColumnBatch> TickCursor::takePrefetchedBatch() {
+    if (!prefetch_thread_.joinable())
+        startPrefetch();
+
+    std::unique_ptr<ColumnBatch> batch;
+    std::string error;
+    {
+        PythonGILReleaseHolder release_gil;
+        std::unique_lock<std::mutex> lock(prefetch_lock_);
+        prefetch_ready_.wait(lock, [this] {
+            return !prefetched_batches_.empty() || prefetch_done_;
+        });
+
+        if (!prefetched_batches_.empty()) {
+            batch = std::move(prefetched_batches_.front());
+            prefetched_batches_.pop_front();
+            prefetch_space_.notify_all();
+        } else {
+            error = prefetch_error_;
+        }
+    }
+
+    if (!error.empty())
+        THROW_EXCEPTION("Error while prefetching messages: %s", error.c_str());
+
+    if (batch == nullptr) {
+        // end of cursor
+        batch = std::unique_ptr<ColumnBatch>(new ColumnBatch());
+        selectFields(*batch);
+    }
+
+    return batch;
 }
 
 void TickCursor::setTimeForNewSubscriptions(DxApi::TimestampMs dt) {
+    stopPrefetch();
     cursor_->setTimeForNewSubscriptions(dt);
 }
 
@@ -6,10 +6,23 @@
 #include "python_common.h"
 #include "dxapi.h"
 
+#include "codecs/decimal64.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+
 namespace TbApiImpl {
 namespace Python {
 
 class MessageCodec;
+class Column;
+class ColumnBatch;
+class LazyMessageChunk;
+struct HeaderColumns;
 
 enum NextResult {
     OK, END_OF_CURSOR, UNAVAILABLE
@@ -23,6 +36,24 @@ public:
     bool next();
     NextResult nextIfAvailable();
     PyObject * getMessage();
+    PyObject * iterator(PyObject *owner);
+    PyObject * nextBatch(int32_t max_messages);
+    PyObject * nextArrowBatch(int32_t max_messages);
+    PyObject * readColumns(const std::vector<std::string> *fields);
+
+    void setFields(const std::vector<std::string> *fields);
+    void setLazyMessages(bool lazy);
+    void setTypedMessages(bool typed);
+    void setPrefetch(int32_t depth, int32_t batch_size);
+
+    // set by methods, which create cursor, prefetching is not available for live cursors
+    void setLive(bool live);
+
+    // mode is 'float', 'raw', 'fixed' or 'decimal', default scale of fixed-point values clears scales of fields
+    void setDecimalMode(const std::string &mode, int32_t scale);
+    void setDecimalScale(const std::string &field, int32_t scale);
+    void setTypedArrays(bool typed);
+    void setBinaryViews(bool views);
 
     bool isAtEnd() const;
     bool isClosed() const;
@@ -61,14 +92,83 @@ private:
 
     DISALLOW_COPY_AND_ASSIGN(TickCursor);
 
+    bool fetchNext();
+    std::shared_ptr<MessageCodec> getMessageDecoder(uint32_t type_id);
     void decodeCurrentMessage();
+    void decodeCurrentMessage(const DxApi::InstrumentMessage &message, ColumnBatch &batch, const HeaderColumns &header);
+    void decodeMessageColumns(const DxApi::InstrumentMessage &message, MessageCodec &message_decoder,
+        ColumnBatch &batch, const HeaderColumns &header);
+    void readBatch(ColumnBatch &batch, size_t max_messages);
+    void prefetchBatch(ColumnBatch &batch, size_t max_messages);
+    void selectFields(ColumnBatch &batch);
     void decodeHeader(PyObject * message);
+    void applyDecimalOptions();
+
+    // header objects are cached by entity and type ids, caches are cleared when subscription changes
+    PyObject * getSymbolObject(int32_t entity_id);
+    PyObject * getTypeNameObject(uint32_t type_id);
+    PyObject * getTypeIdObject(uint32_t type_id);
+    void clearHeaderCache();
+    void clearMessageObjects();
+
+    void decodeLazyMessage();
+    PyObject * getLazyMessage();
+    void clearLazyMessages();
+
+    // batches are read by background thread, which owns cursor and decoders until prefetching is stopped,
+    // message objects are not available, while batches are prefetched
+    void startPrefetch();
+    void stopPrefetch();
+    void prefetchBatches();
+    std::unique_ptr<ColumnBatch> takePrefetchedBatch();
+    void checkNotPrefetching(const char *method);
 
     std::unique_ptr<DxApi::TickCursor> cursor_ = nullptr;
     std::shared_ptr<DxApi::InstrumentMessage> instrument_message_ = nullptr;
     std::vector<std::shared_ptr<MessageCodec>> message_decoders_;
     std::vector<PyObject *> message_objects_;
 
+    std::unique_ptr<ColumnBatch> column_batch_;
+
+    // selected fields of messages, NULL if all fields are selected
+    std::unique_ptr<std::unordered_set<std::string>> fields_;
+
+    DecimalOptions decimal_options_;
+    bool typed_arrays_ = false;
+    bool binary_views_ = false;
+
+    // messages are objects of classes with slots for fields, generated per message class
+    bool typed_messages_ = false;
+
+    // lazy messages are decoded into chunks by type id, accessors own chunks,
+    // object of the current message is created by the first getMessage()
+    bool lazy_messages_ = false;
+    PyObject *lazy_message_ = NULL;
+    // current message is the last row of its chunk (false, if it wasn't decoded or its decoding failed)
+    bool lazy_message_decoded_ = false;
+    std::vector<LazyMessageChunk *> lazy_chunks_;
+    std::vector<PyObject *> lazy_accessors_;
+
+    // live cursors wait for data in next(), so they are not prefetched
+    bool live_ = false;
+
+    // number of batches read ahead, 0 if prefetching is disabled
+    size_t prefetch_depth_ = 0;
+    size_t prefetch_batch_size_ = 0;
+    std::thread prefetch_thread_;
+    DxApi::InstrumentMessage prefetch_message_;
+    std::mutex prefetch_lock_;
+    std::condition_variable prefetch_ready_;
+    std::condition_variable prefetch_space_;
+    std::deque<std::unique_ptr<ColumnBatch>> prefetched_batches_;
+    std::atomic<bool> prefetch_stop_;
+    bool prefetch_done_ = false;
+    std::string prefetch_error_;
+
+    std::vector<PyObject *> symbol_objects_;
+    std::vector<PyObject *> type_name_objects_;
+    std::vector<PyObject *> type_id_objects_;
+
     PythonTbApiModule tbapi_module_;
 
     PyObject *  TYPE_ID_PROPERTY1 = PyUnicode_FromString("typeId");
@@ -2,13 +2,181 @@
 
 #include "python_common.h"
 #include "codecs/message_codec.h"
+#include "codecs/codec_cache.h"
+#include "codecs/column_source.h"
+#include "codecs/attribute_reader.h"
 
 #include <thread>
 #include <chrono>
+#include <functional>
+#include <condition_variable>
 
 namespace TbApiImpl {
 namespace Python {
 
+static const char *FAST_METHODS_CAPSULE_NAME = "tbapi.TickLoaderMethods";
+
+// max number of strings in every identity cache of ids, cache is cleared when it's exceeded
+static const size_t MAX_CACHED_STRINGS = 4096;
+
+// indexes of header properties in header reader
+enum HeaderProperty {
+    TYPE_ID_HEADER, TYPE_NAME_HEADER, INSTRUMENT_ID_HEADER, SYMBOL_HEADER, TIMESTAMP_HEADER
+};
+
+// Loader of parallel sendColumns with messages of its symbols and codecs, which are used by one thread.
+struct LoaderWorker {
+    DxApi::TickLoader *loader = NULL;
+    std::unique_ptr<DxApi::TickLoader> own_loader;
+
+    std::vector<MessageCodecPtr> codecs;
+    std::unordered_map<std::string, int32_t> symbol_to_id;
+
+    // rows of current call, their instrument ids in loader and number of sent rows
+    std::vector<size_t> rows;
+    std::vector<int32_t> instrument_ids;
+    size_t sent = 0;
+    std::string error;
+};
+
+// Message of asynchronous loader: header and tuple of field values, which are read from python message by send.
+struct AsyncMessage {
+    uint32_t type_id;
+    int32_t instrument_id;
+    DxApi::TimestampMs timestamp;
+    PyObject *values;
+};
+
+// Bounded queue of messages between sending threads and background thread of loader.
+struct AsyncQueue {
+    std::mutex lock;
+    std::condition_variable not_empty;
+    std::condition_variable not_full;
+    std::condition_variable flushed;
+
+    std::vector<AsyncMessage> messages;
+    size_t capacity = 0;
+    bool drop_on_overflow = false;
+    int32_t flush_period_ms = 0;
+
+    bool stopping = false;
+    bool stopped = false;
+    size_t dropped = 0;
+    uint64_t flush_requested = 0;
+    uint64_t flush_done = 0;
+
+    // the first error of background thread, it's raised by the next send or flush
+    std::string error;
+
+    std::thread thread;
+};
+
+// Threads don't wait for lock of loader with GIL held: thread with lock may wait for GIL,
+// while loader sends or flushes messages without GIL.
+static void lockLoader(std::unique_lock<std::mutex> &loader_lock) {
+    if (!loader_lock.try_lock()) {
+        PythonGILReleaseHolder release_gil;
+        loader_lock.lock();
+    }
+}
+
+// sends message, which is encoded under lock of loader, loader may be blocked by server without GIL
+static void sendLocked(DxApi::TickLoader &loader, std::unique_lock<std::mutex> &loader_lock) {
+    PythonGILReleaseHolder release_gil;
+    loader.send();
+    loader_lock.unlock();
+}
+
+// self of fast methods: weak reference to python loader, loader is deleted with it
+struct LoaderMethodsContext {
+    TickLoader *loader;
+    PyObject *owner_ref;
+};
+
+static void deleteMethodsContext(PyObject *capsule) {
+    LoaderMethodsContext *context =
+        (LoaderMethodsContext *) PyCapsule_GetPointer(capsule, FAST_METHODS_CAPSULE_NAME);
+    if (context == NULL)
+        return;
+
+    Py_XDECREF(context->owner_ref);
+    delete context;
+}
+
+static TickLoader * getMethodsLoader(PyObject *self) {
+    LoaderMethodsContext *context =
+        (LoaderMethodsContext *) PyCapsule_GetPointer(self, FAST_METHODS_CAPSULE_NAME);
+    if (context == NULL)
+        return NULL;
+
+    if (PyWeakref_GetObject(context->owner_ref) == Py_None) {
+        PyErr_SetString(PyExc_Exception, "Loader is deleted.");
+        return NULL;
+    }
+
+    return context->loader;
+}
+
+static PyObject * fastSend(PyObject *self, PyObject *message) {
+    TickLoader *loader = getMethodsLoader(self);
+    if (loader == NULL)
+        return NULL;
+
+    try {
+        loader->send(message);
+    } catch (const std::exception &e) {
+        PyErr_SetString(PyExc_Exception, e.what());
+        return NULL;
+    } catch (...) {
+        PyErr_SetString(PyExc_Exception, "Unknown error.");
+        return NULL;
+    }
+
+    Py_RETURN_NONE;
+}
+
+static PyObject * fastSendBatch(PyObject *self, PyObject *messages) {
+    TickLoader *loader = getMethodsLoader(self);
+    if (loader == NULL)
+        return NULL;
+
+    try {
+        return PyLong_FromSize_t(loader->sendBatch(messages));
+    } catch (const std::exception &e) {
+        PyErr_SetString(PyExc_Exception, e.what());
+        return NULL;
+    } catch (...) {
+        PyErr_SetString(PyExc_Exception, "Unknown error.");
+        return NULL;
+    }
+}
+
+static PyObject * fastFlush(PyObject *self, PyObject *unused) {
+    TickLoader *loader = getMethodsLoader(self);
+    if (loader == NULL)
+        return NULL;
+
+    try {
+        loader->flush();
+    } catch (const std::exception &e) {
+        PyErr_SetString(PyExc_Exception, e.what());
+        return NULL;
+    } catch (...) {
+        PyErr_SetString(PyExc_Exception, "Unknown error.");
+        return NULL;
+    }
+
+    Py_RETURN_NONE;
+}
+
+// single argument methods get it without argument tuple, like METH_FASTCALL
+static PyMethodDef FAST_METHODS[] = {
+    { "send", fastSend, METH_O, "Sends message." },
+    { "sendBatch", fastSendBatch, METH_O, "Sends list of messages, returns number of sent messages." },
+    { "flush", fastFlush, METH_NOARGS, "Flushes all buffered messages." },
+    { NULL, NULL, 0, NULL }
+};
+
 TickLoader::TickLoader(DxApi::TickLoader *loader) {
     loader_ = std::unique_ptr<DxApi::TickLoader>(loader);
 
@@ -16,17 +184,27 @@ TickLoader::TickLoader(DxApi::TickLoader *loader) {
     if (!metadata.has_value())
         THROW("Empty stream schema.");
 
-    descriptors_ = Schema::TickDbClassDescriptor::parseDescriptors(metadata.get(), true);
+    schema_ = CodecCache::instance().getSchema(metadata.get());
+
+    header_reader_.reset(new AttributeReader({
+        TYPE_ID_PROPERTY1, TYPE_NAME_PROPERTY1, INSTRUMENT_ID_PROPERTY1, SYMBOL_PROPERTY1, TIMESTAMP_PROPERTY1
+    }));
 }
 
 TickLoader::~TickLoader() {
+    clearCachedIds(type_name_ids_);
+    clearCachedIds(symbol_ids_);
+
     Py_DECREF(TYPE_ID_PROPERTY1);
     Py_DECREF(TYPE_NAME_PROPERTY1);
     Py_DECREF(INSTRUMENT_ID_PROPERTY1);
     Py_DECREF(SYMBOL_PROPERTY1);
     Py_DECREF(TIMESTAMP_PROPERTY1);
 
+    // errors of background thread are raised by close, loader is deleted without raising them
+    stopAsync();
     clearListeners();
+    closeWorkers();
     freeListeners();
 
     if (loader_ == nullptr)
@@ -43,6 +221,10 @@ void TickLoader::clearListeners() {
         LoaderErrorListener *errorListener = it->second;
         if (errorListener != 0) {
             loader_->removeListener(errorListener);
+            for (std::unique_ptr<LoaderWorker> &worker : workers_) {
+                if (worker->own_loader != nullptr)
+                    worker->loader->removeListener(errorListener);
+            }
             removedListeners_.push_back(errorListener);
         }
     }
@@ -66,49 +248,700 @@ uint32_t TickLoader::registerType(const std::string &type_name) {
             THROW_EXCEPTION("Type '%s' not found in stream schema.", type_name.c_str());
 
         std::shared_ptr<MessageCodec> new_message_codec = 
-            std::shared_ptr<MessageCodec>(new MessageCodec(descriptors_, descriptor_id));
+            CodecCache::instance().acquireCodec(schema_, descriptor_id);
 
-        while (message_codecs_.size() <= next_id_)
-            message_codecs_.push_back(NULL);
-        message_codecs_[next_id_] = new_message_codec;
-        type_to_id_[type_name] = next_id_;
-        loader_->registerMessageType(next_id_, type_name);
+        // GIL may be released by locking of loader, so other thread may register the type meanwhile
+        std::unique_lock<std::mutex> loader_lock(loader_lock_, std::defer_lock);
+        lockLoader(loader_lock);
+        it = type_to_id_.find(type_name);
+        if (it != type_to_id_.end())
+            return it->second;
+
+        // loaders of workers are used by parallel sendColumns under the same lock
+        uint32_t type_id = next_id_++;
+        loader_->registerMessageType(type_id, type_name);
+        for (std::unique_ptr<LoaderWorker> &worker : workers_) {
+            if (worker->own_loader != nullptr)
+                worker->loader->registerMessageType(type_id, type_name);
+        }
 
-        return next_id_++;
+        while (message_codecs_.size() <= type_id)
+            message_codecs_.push_back(NULL);
+        message_codecs_[type_id] = new_message_codec;
+        type_to_id_[type_name] = type_id;
+        return type_id;
     }
         
     return it->second;
 }
 
 uint32_t TickLoader::registerInstrument(const std::string &instrument) {
+    std::unique_lock<std::mutex> loader_lock(loader_lock_, std::defer_lock);
+    lockLoader(loader_lock);
     return loader_->getInstrumentId(instrument);
 }
 
 void TickLoader::send(PyObject *message) {
-    int32_t type_id = getTypeId(message);
-    int32_t instrument_id = getInstrumentId(message);
-    DxApi::TimestampMs timestamp = getTimestamp(message);
+    AttributeAccessor header(*header_reader_, message);
+    int32_t type_id = getTypeId(header);
+    int32_t instrument_id = getInstrumentId(header);
+    DxApi::TimestampMs timestamp = getTimestamp(header);
+
+    // loader can't discard started message, so values are validated before message is started
+    MessageCodec &codec = *message_codecs_[type_id];
+    PythonRefHolder values(codec.getValues(message));
+    if (async_ != nullptr) {
+        codec.validateValues(values.getReference());
+        Py_INCREF(values.getReference());
+        return sendAsync(type_id, instrument_id, timestamp, values.getReference());
+    }
 
+    std::unique_lock<std::mutex> loader_lock(loader_lock_, std::defer_lock);
+    lockLoader(loader_lock);
+    codec.validateValues(values.getReference());
     DxApi::DataWriter &writer = loader_->beginMessage(type_id, instrument_id, timestamp);
-    message_codecs_[type_id]->encode(message, writer);
-    loader_->send();
+    codec.encodeValues(values.getReference(), writer);
+    sendLocked(*loader_, loader_lock);
+}
+
+size_t TickLoader::sendBatch(PyObject *messages) {
+    PythonRefHolder sequence(PySequence_Fast(messages, ""));
+    if (sequence.getReference() == NULL) {
+        PyErr_Clear();
+        THROW("Messages should be a sequence.");
+    }
+
+    // GIL is released by sending, so list may be changed by other threads between messages
+    Py_ssize_t i = 0;
+    for (; i < PySequence_Fast_GET_SIZE(sequence.getReference()); ++i) {
+        PyObject *message = PySequence_Fast_GET_ITEM(sequence.getReference(), i);
+        Py_INCREF(message);
+        PythonRefHolder message_holder(message);
+        try {
+            send(message);
+        } catch (const std::exception &e) {
+            THROW_EXCEPTION("Can't send message %d of batch: %s", (int) i, e.what());
+        }
+    }
+
+    return (size_t) i;
+}
+
+PyObject * TickLoader::fastMethods(PyObject *owner) {
+    PyObject *owner_ref = PyWeakref_NewRef(owner, NULL);
+    if (owner_ref == NULL)
+        THROW("Can't create weak reference to loader.");
+
+    LoaderMethodsContext *context = new LoaderMethodsContext();
+    context->loader = this;
+    context->owner_ref = owner_ref;
+
+    PythonRefHolder capsule(PyCapsule_New(context, FAST_METHODS_CAPSULE_NAME, deleteMethodsContext));
+    if (capsule.getReference() == NULL) {
+        Py_DECREF(owner_ref);
+        delete context;
+        THROW("Can't create capsule of loader methods.");
+    }
+
+    PythonRefHolder methods(PyDict_New());
+    for (PyMethodDef *definition = FAST_METHODS; definition->ml_name != NULL; ++definition) {
+        PythonRefHolder method(PyCFunction_New(definition, capsule.getReference()));
+        if (method.getReference() == NULL)
+            THROW_EXCEPTION("Can't create method '%s' of loader.", definition->ml_name);
+        PyDict_SetItemString(methods.getReference(), definition->ml_name, method.getReference());
+    }
+
+    PyObject *result = methods.getReference();
+    Py_INCREF(result);
+    return result;
+}
+
+static int64_t getColumnInt64(const ColumnSource &source, size_t row, int64_t null_value) {
+    int64_t value;
+    if (source.isNumeric())
+        return source.getInt64(row, value) ? value : null_value;
+
+    PythonRefHolder object(source.getObject(row));
+    bool type_mismatch;
+    bool exists = getInt64Value(object.getReference(), value, type_mismatch);
+    if (type_mismatch)
+        THROW_EXCEPTION("Wrong type of '%s' value in row %d. Required: INTEGER.", source.getName().c_str(), (int) row);
+
+    return exists ? value : null_value;
+}
+
+// encodes rows of worker in its thread, nulls and numeric columns are encoded without python API,
+// rows with python objects are validated before threads are started and GIL is held only while they are encoded
+static void encodeWorkerRows(LoaderWorker &worker, uint32_t type_id, const std::vector<DxApi::TimestampMs> &timestamps,
+    const std::vector<const ColumnSource *> &sources, bool needs_gil)
+{
+    // thread state is kept by the thread, so GIL is taken for every row without creating thread state
+    std::unique_ptr<PythonGILLockHolder> thread_state;
+    std::unique_ptr<PythonGILReleaseHolder> release_gil;
+    if (needs_gil) {
+        thread_state.reset(new PythonGILLockHolder());
+        release_gil.reset(new PythonGILReleaseHolder());
+    }
+
+    try {
+        MessageCodec &codec = *worker.codecs[type_id];
+        for (size_t i = 0; i < worker.rows.size(); ++i) {
+            size_t row = worker.rows[i];
+            if (needs_gil) {
+                // objects (e.g. lists of array fields) may be changed by other python threads since validation,
+                // so row is validated again and encoded under the same GIL, started message is always completed
+                PythonGILLockHolder gil;
+                codec.validate(sources, row);
+                DxApi::DataWriter &writer = worker.loader->beginMessage(type_id, worker.instrument_ids[i], timestamps[row]);
+                codec.encode(sources, row, writer);
+            } else {
+                codec.validate(sources, row);
+                DxApi::DataWriter &writer = worker.loader->beginMessage(type_id, worker.instrument_ids[i], timestamps[row]);
+                codec.encode(sources, row, writer);
+            }
+            worker.loader->send();
+            ++worker.sent;
+        }
+    } catch (const std::exception &e) {
+        worker.error = e.what();
+    } catch (...) {
+        worker.error = "Unknown error.";
+    }
+}
+
+size_t TickLoader::sendColumns(const std::string &type_name, PyObject *symbols, PyObject *timestamps, PyObject *columns) {
+    if (async_ != nullptr)
+        THROW("Columns can't be sent by asynchronous loader.");
+    if (!PyDict_Check(columns))
+        THROW("Columns should be a dict of field values.");
+
+    uint32_t type_id = registerType(type_name);
+    MessageCodec &codec = *message_codecs_[type_id];
+
+    ColumnSource timestamp_source(TIMESTAMP_PROPERTY, timestamps);
+    size_t size = timestamp_source.size();
+
+    // single symbol for all rows, or symbol (instrument id) per row
+    int32_t instrument_id = INT32_MIN;
+    std::unique_ptr<ColumnSource> symbol_source;
+    std::string symbol;
+    bool type_mismatch;
+    bool single_symbol = getStringValue(symbols, symbol, type_mismatch);
+    if (!single_symbol) {
+        symbol_source.reset(new ColumnSource(SYMBOL_PROPERTY, symbols));
+        if (symbol_source->size() != size)
+            THROW_EXCEPTION("Number of symbols (%d) differs from number of timestamps (%d).",
+                (int) symbol_source->size(), (int) size);
+    }
+
+    std::vector<std::unique_ptr<ColumnSource>> field_sources;
+    std::vector<const ColumnSource *> sources(codec.getFieldsCount(), NULL);
+    PyObject *key;
+    PyObject *values;
+    Py_ssize_t position = 0;
+    while (PyDict_Next(columns, &position, &key, &values)) {
+        std::string field_name;
+        if (!getStringValue(key, field_name, type_mismatch) || type_mismatch)
+            THROW("Names of columns should be strings.");
+
+        size_t index = 0;
+        while (index < sources.size() && field_name != codec.getFieldName(index))
+            ++index;
+        if (index == sources.size())
+            THROW_EXCEPTION("Field '%s' not found in type '%s'.", field_name.c_str(), type_name.c_str());
+
+        field_sources.push_back(std::unique_ptr<ColumnSource>(new ColumnSource(field_name, values)));
+        if (field_sources.back()->size() != size)
+            THROW_EXCEPTION("Number of values of field '%s' (%d) differs from number of timestamps (%d).",
+                field_name.c_str(), (int) field_sources.back()->size(), (int) size);
+        sources[index] = field_sources.back().get();
+    }
+
+    if (workers_.size() > 1)
+        return sendColumnsParallel(type_name, type_id, single_symbol ? &symbol : NULL, symbol_source.get(), timestamp_source, sources, size);
+
+    if (single_symbol)
+        instrument_id = getSymbolId(symbol);
+
+    // columns of numeric buffers and nulls are sent without GIL
+    bool numeric = timestamp_source.isNumeric() && (symbol_source == nullptr || symbol_source->isNumeric());
+    for (const ColumnSource *source : sources)
+        numeric &= source == NULL || source->isNumeric();
+
+    if (numeric) {
+        PythonGILReleaseHolder release_gil;
+        MutexHolder loader_holder(&loader_lock_);
+        for (size_t row = 0; row < size; ++row) {
+            DxApi::TimestampMs timestamp = getColumnInt64(timestamp_source, row, DxApi::TIMESTAMP_UNKNOWN);
+            if (symbol_source != nullptr) {
+                instrument_id = (int32_t) getColumnInt64(*symbol_source, row, INT32_MIN);
+                if (instrument_id == INT32_MIN)
+                    THROW_EXCEPTION("Unknown instrument of row %d.", (int) row);
+            }
+
+            codec.validate(sources, row);
+            DxApi::DataWriter &writer = loader_->beginMessage(type_id, instrument_id, timestamp);
+            codec.encode(sources, row, writer);
+            loader_->send();
+        }
+
+        return size;
+    }
+
+    for (size_t row = 0; row < size; ++row) {
+        DxApi::TimestampMs timestamp = getColumnInt64(timestamp_source, row, DxApi::TIMESTAMP_UNKNOWN);
+
+        if (symbol_source != nullptr) {
+            if (symbol_source->isNumeric()) {
+                instrument_id = (int32_t) getColumnInt64(*symbol_source, row, INT32_MIN);
+            } else {
+                PythonRefHolder symbol_object(symbol_source->getObject(row));
+                if (!getStringValue(symbol_object.getReference(), symbol, type_mismatch) || type_mismatch)
+                    THROW_EXCEPTION("Wrong type of symbol in row %d. Required: STRING.", (int) row);
+                instrument_id = getSymbolId(symbol);
+            }
+
+            if (instrument_id == INT32_MIN)
+                THROW_EXCEPTION("Unknown instrument of row %d.", (int) row);
+        }
+
+        std::unique_lock<std::mutex> loader_lock(loader_lock_, std::defer_lock);
+        lockLoader(loader_lock);
+        codec.validate(sources, row);
+        DxApi::DataWriter &writer = loader_->beginMessage(type_id, instrument_id, timestamp);
+        codec.encode(sources, row, writer);
+        sendLocked(*loader_, loader_lock);
+    }
+
+    return size;
+}
+
+size_t TickLoader::sendColumnsParallel(const std::string &type_name, uint32_t type_id, const std::string *symbol, const ColumnSource *symbol_source,
+    const ColumnSource &timestamp_source, const std::vector<const ColumnSource *> &sources, size_t size)
+{
+    // workers and their loaders (the first one is shared with send() of other threads) are used under lock of loader,
+    // GIL is released, while lock is awaited
+    std::unique_lock<std::mutex> loader_lock(loader_lock_, std::defer_lock);
+    lockLoader(loader_lock);
+
+    for (std::unique_ptr<LoaderWorker> &worker : workers_) {
+        worker->rows.clear();
+        worker->instrument_ids.clear();
+        worker->sent = 0;
+        worker->error.clear();
+    }
+
+    // python objects of timestamps and symbols are read before threads are started
+    std::vector<DxApi::TimestampMs> timestamps(size);
+    for (size_t row = 0; row < size; ++row)
+        timestamps[row] = getColumnInt64(timestamp_source, row, DxApi::TIMESTAMP_UNKNOWN);
+
+    if (symbol != NULL) {
+        int32_t instrument_id;
+        LoaderWorker &worker = getSymbolWorker(*symbol, instrument_id);
+        for (size_t row = 0; row < size; ++row) {
+            worker.rows.push_back(row);
+            worker.instrument_ids.push_back(instrument_id);
+        }
+    } else {
+        if (symbol_source->isNumeric())
+            THROW("Instrument ids are not supported by parallel loader. Specify symbols.");
+
+        std::string row_symbol;
+        bool type_mismatch;
+        for (size_t row = 0; row < size; ++row) {
+            PythonRefHolder symbol_object(symbol_source->getObject(row));
+            if (!getStringValue(symbol_object.getReference(), row_symbol, type_mismatch) || type_mismatch)
+                THROW_EXCEPTION("Wrong type of symbol in row %d. Required: STRING.", (int) row);
+
+            int32_t instrument_id;
+            LoaderWorker &worker = getSymbolWorker(row_symbol, instrument_id);
+            worker.rows.push_back(row);
+            worker.instrument_ids.push_back(instrument_id);
+        }
+    }
+
+    bool needs_gil = false;
+    for (const ColumnSource *source : sources)
+        needs_gil |= source != NULL && !source->isNumeric();
+
+    // codecs are created under GIL
+    for (std::unique_ptr<LoaderWorker> &worker : workers_) {
+        while (worker->codecs.size() <= type_id)
+            worker->codecs.push_back(NULL);
+        if (!worker->rows.empty() && worker->codecs[type_id] == nullptr)
+            worker->codecs[type_id] = CodecCache::instance().acquireCodec(schema_, findDescriptor(type_name));
+    }
+
+    // python objects are validated under GIL, which is held by this thread, before any row is sent,
+    // numeric rows are validated by workers
+    if (needs_gil) {
+        MessageCodec &codec = *message_codecs_[type_id];
+        for (size_t row = 0; row < size; ++row)
+            codec.validate(sources, row);
+    }
+
+    {
+        // the first worker sends messages by loader
+        PythonGILReleaseHolder release_gil;
+        std::vector<std::thread> threads;
+        for (std::unique_ptr<LoaderWorker> &worker : workers_) {
+            if (!worker->rows.empty())
+                threads.push_back(std::thread(encodeWorkerRows, std::ref(*worker), type_id, std::cref(timestamps), std::cref(sources), needs_gil));
+        }
+
+        for (std::thread &thread : threads)
+            thread.join();
+    }
+
+    // workers send rows independently, so rows sent by other workers are reported with error
+    std::string error;
+    std::string sent;
+    for (std::unique_ptr<LoaderWorker> &worker : workers_) {
+        if (error.empty())
+            error = worker->error;
+        sent += (sent.empty() ? "" : ", ") + std::to_string(worker->sent) + "/" + std::to_string(worker->rows.size());
+    }
+
+    if (!error.empty())
+        THROW_EXCEPTION("Can't send columns by parallel loader: %s Rows sent by workers: %s.", error.c_str(), sent.c_str());
+
+    return size;
+}
+
+// is called under lock of loader
+LoaderWorker & TickLoader::getSymbolWorker(const std::string &symbol, int32_t &instrument_id) {
+    if (symbol.empty())
+        THROW("Symbol is empty.");
+
+    // worker of symbol doesn't change, so messages of symbol are sent in order by one loader
+    LoaderWorker &worker = *workers_[std::hash<std::string>()(symbol) % workers_.size()];
+    auto it = worker.symbol_to_id.find(symbol);
+    if (it != worker.symbol_to_id.end()) {
+        instrument_id = it->second;
+    } else {
+        instrument_id = worker.loader->getInstrumentId(symbol);
+        worker.symbol_to_id[symbol] = instrument_id;
+    }
+
+    return worker;
+}
+
+void TickLoader::setWorkers(size_t workers, const DxApi::LoadingOptions &options) {
+    if (workers == 0)
+        THROW("Number of workers should be positive.");
+    if (async_ != nullptr && workers > 1)
+        THROW("Parallel loader can't be asynchronous.");
+
+    closeWorkers();
+    if (workers == 1)
+        return;
+
+    workers_.push_back(std::unique_ptr<LoaderWorker>(new LoaderWorker()));
+    workers_[0]->loader = loader_.get();
+    for (size_t i = 1; i < workers; ++i) {
+        std::unique_ptr<LoaderWorker> worker(new LoaderWorker());
+        worker->own_loader.reset(loader_->stream()->createLoader(options));
+        if (worker->own_loader == nullptr)
+            THROW("Can't create loader of worker.");
+        worker->loader = worker->own_loader.get();
+
+        // types have the same ids in all loaders
+        for (const auto &type : type_to_id_)
+            worker->loader->registerMessageType(type.second, type.first);
+
+        MutexHolder mutex_holder(&errorListenerLock_);
+        for (const auto &listener : errorListeners_) {
+            if (listener.second != 0)
+                worker->loader->addListener(listener.second);
+        }
+
+        workers_.push_back(std::move(worker));
+    }
+}
+
+void TickLoader::closeWorkers() {
+    {
+        MutexHolder mutex_holder(&errorListenerLock_);
+        for (std::unique_ptr<LoaderWorker> &worker : workers_) {
+            if (worker->own_loader == nullptr)
+                continue;
+
+            for (const auto &listener : errorListeners_) {
+                if (listener.second != 0)
+                    worker->loader->removeListener(listener.second);
+            }
+        }
+    }
+
+    {
+        PythonGILReleaseHolder release_gil;
+        for (std::unique_ptr<LoaderWorker> &worker : workers_) {
+            try {
+                if (worker->own_loader != nullptr && !worker->own_loader->isClosed())
+                    worker->own_loader->close();
+            } catch (...) {
+                std::cout << "Error occured while closing loader of worker" << std::endl;
+            }
+        }
+    }
+
+    // codecs are released under GIL
+    workers_.clear();
+}
+
+void TickLoader::setAsync(size_t queue_size, bool drop_on_overflow, int32_t flush_period_ms) {
+    if (queue_size > 0 && workers_.size() > 1)
+        THROW("Parallel loader can't be asynchronous.");
+
+    std::string error = stopAsync();
+    if (!error.empty())
+        THROW_EXCEPTION("Can't send message by background thread: %s", error.c_str());
+    if (queue_size == 0)
+        return;
+
+    std::shared_ptr<AsyncQueue> queue(new AsyncQueue());
+    queue->capacity = queue_size;
+    queue->drop_on_overflow = drop_on_overflow;
+    queue->flush_period_ms = flush_period_ms;
+    queue->messages.reserve(queue_size);
+    queue->thread = std::thread(&TickLoader::runAsync, this, queue);
+    async_ = queue;
+}
+
+size_t TickLoader::nDroppedMessages() {
+    std::shared_ptr<AsyncQueue> queue = async_;
+    if (queue == nullptr)
+        return 0;
+
+    MutexHolder queue_holder(&queue->lock);
+    return queue->dropped;
+}
+
+// takes reference to values, which is released by background thread
+void TickLoader::sendAsync(uint32_t type_id, int32_t instrument_id, DxApi::TimestampMs timestamp, PyObject *values) {
+    // queue is kept by this thread, while it waits without GIL and other thread stops queue
+    std::shared_ptr<AsyncQueue> queue_holder = async_;
+    AsyncQueue &queue = *queue_holder;
+    AsyncMessage message = { type_id, instrument_id, timestamp, values };
+
+    std::string error;
+    bool enqueued = false;
+    bool dropped = false;
+    bool closed = false;
+    {
+        MutexHolder queue_lock(&queue.lock);
+        error.swap(queue.error);
+        closed = queue.stopping;
+        if (error.empty() && !closed) {
+            if (queue.messages.size() < queue.capacity) {
+                queue.messages.push_back(message);
+                enqueued = true;
+                if (queue.messages.size() == 1)
+                    queue.not_empty.notify_one();
+            } else if (queue.drop_on_overflow) {
+                ++queue.dropped;
+                dropped = true;
+            }
+        }
+    }
+
+    if (error.empty() && !closed && !enqueued && !dropped) {
+        // background thread takes GIL to encode messages
+        PythonGILReleaseHolder release_gil;
+        std::unique_lock<std::mutex> queue_lock(queue.lock);
+        queue.not_full.wait(queue_lock, [&queue] { return queue.messages.size() < queue.capacity || queue.stopping; });
+        closed = queue.stopping;
+        if (!closed) {
+            queue.messages.push_back(message);
+            queue.not_empty.notify_one();
+            enqueued = true;
+        }
+    }
+
+    if (enqueued)
+        return;
+
+    Py_DECREF(values);
+    if (closed)
+        THROW("Loader is closed.");
+    if (!error.empty())
+        THROW_EXCEPTION("Can't send message by background thread: %s", error.c_str());
+}
+
+void TickLoader::runAsync(std::shared_ptr<AsyncQueue> queue_holder) {
+    // thread state is kept by the thread, so GIL is taken for every message without creating thread state
+    PythonGILLockHolder thread_state;
+    PythonGILReleaseHolder release_gil;
+
+    AsyncQueue &queue = *queue_holder;
+    std::vector<AsyncMessage> batch;
+    batch.reserve(queue.capacity);
+    std::chrono::steady_clock::time_point last_flush = std::chrono::steady_clock::now();
+    bool not_flushed = false;
+    while (true) {
+        uint64_t flush_requested;
+        bool stopping;
+        {
+            std::unique_lock<std::mutex> queue_lock(queue.lock);
+            auto ready = [&queue] {
+                return !queue.messages.empty() || queue.stopping || queue.flush_requested != queue.flush_done;
+            };
+            if (not_flushed && queue.flush_period_ms > 0)
+                queue.not_empty.wait_until(queue_lock, last_flush + std::chrono::milliseconds(queue.flush_period_ms), ready);
+            else
+                queue.not_empty.wait(queue_lock, ready);
+
+            batch.swap(queue.messages);
+            flush_requested = queue.flush_requested;
+            stopping = queue.stopping;
+            queue.not_full.notify_all();
+        }
+
+        std::string error;
+        for (AsyncMessage &message : batch) {
+            std::unique_lock<std::mutex> loader_lock(loader_lock_, std::defer_lock);
+            try {
+                {
+                    PythonGILLockHolder gil;
+                    PythonRefHolder values(message.values);
+                    MessageCodec &codec = *message_codecs_[message.type_id];
+                    lockLoader(loader_lock);
+
+                    // values are validated by send, but mutable values (e.g. lists) may be changed since then
+                    codec.validateValues(values.getReference());
+                    DxApi::DataWriter &writer = loader_->beginMessage(message.type_id, message.instrument_id, message.timestamp);
+                    codec.encodeValues(values.getReference(), writer);
+                }
+
+                // GIL is released, while loader is blocked by sending
+                loader_->send();
+                not_flushed = true;
+            } catch (const std::exception &e) {
+                if (error.empty())
+                    error = e.what();
+            } catch (...) {
+                if (error.empty())
+                    error = "Unknown error.";
+            }
+        }
+        batch.clear();
+
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        bool flush = stopping || flush_requested != queue.flush_done ||
+            (queue.flush_period_ms > 0 && now - last_flush >= std::chrono::milliseconds(queue.flush_period_ms));
+        if (flush && not_flushed) {
+            try {
+                MutexHolder loader_holder(&loader_lock_);
+                loader_->flush();
+            } catch (const std::exception &e) {
+                if (error.empty())
+                    error = e.what();
+            } catch (...) {
+                if (error.empty())
+                    error = "Unknown error.";
+            }
+
+            not_flushed = false;
+            last_flush = now;
+        }
+
+        MutexHolder queue_holder(&queue.lock);
+        if (!error.empty() && queue.error.empty())
+            queue.error = error;
+        queue.flush_done = flush_requested;
+        queue.flushed.notify_all();
+        if (stopping && queue.messages.empty())
+            break;
+    }
+}
+
+void TickLoader::flushAsync() {
+    std::shared_ptr<AsyncQueue> queue_holder = async_;
+    AsyncQueue &queue = *queue_holder;
+    std::string error;
+    {
+        PythonGILReleaseHolder release_gil;
+        std::unique_lock<std::mutex> queue_lock(queue.lock);
+        uint64_t request = ++queue.flush_requested;
+        queue.not_empty.notify_one();
+        queue.flushed.wait(queue_lock, [&queue, request] { return queue.flush_done >= request || queue.stopped; });
+        error.swap(queue.error);
+    }
+
+    if (!error.empty())
+        THROW_EXCEPTION("Can't send message by background thread: %s", error.c_str());
+}
+
+std::string TickLoader::stopAsync() {
+    std::shared_ptr<AsyncQueue> queue = async_;
+    if (queue == nullptr)
+        return std::string();
+
+    std::string error;
+    {
+        // background thread takes GIL to encode the rest of messages
+        PythonGILReleaseHolder release_gil;
+        bool join;
+        {
+            MutexHolder queue_lock(&queue->lock);
+            join = !queue->stopping;
+            queue->stopping = true;
+        }
+        queue->not_empty.notify_one();
+        queue->not_full.notify_all();
+
+        // the first stopping thread joins background thread, others wait for it
+        if (join)
+            queue->thread.join();
+
+        std::unique_lock<std::mutex> queue_lock(queue->lock);
+        if (join) {
+            queue->stopped = true;
+            queue->flushed.notify_all();
+        } else {
+            queue->flushed.wait(queue_lock, [&queue] { return queue->stopped; });
+        }
+        error.swap(queue->error);
+    }
+
+    if (async_ == queue)
+        async_.reset();
+    return error;
 }
 
 void TickLoader::flush() {
+    if (async_ != nullptr)
+        return flushAsync();
+
+    // loaders are blocked by server without GIL
+    PythonGILReleaseHolder release_gil;
+    MutexHolder loader_holder(&loader_lock_);
     loader_->flush();
+    for (std::unique_ptr<LoaderWorker> &worker : workers_) {
+        if (worker->own_loader != nullptr)
+            worker->own_loader->flush();
+    }
 }
 
 void TickLoader::close() {
+    std::string error = stopAsync();
     clearListeners();
 
     Py_BEGIN_ALLOW_THREADS;
     try {
+        MutexHolder loader_holder(&loader_lock_);
         loader_->close();
     }
     catch (...) {
         std::cout << "Error occured while closing loader" << std::endl;
     }
     Py_END_ALLOW_THREADS;
+
+    closeWorkers();
+
+    if (!error.empty())
+        THROW_EXCEPTION("Can't send message by background thread: %s", error.c_str());
 }
 
 void TickLoader::addListener(DxApi::TickLoader::ErrorListener * listener) {
@@ -117,6 +950,10 @@ void TickLoader::addListener(DxApi::TickLoader::ErrorListener * listener) {
     LoaderErrorListener * loaderListener = new LoaderErrorListener(listener);
     errorListeners_[listener] = loaderListener;
     loader_->addListener(loaderListener);
+    for (std::unique_ptr<LoaderWorker> &worker : workers_) {
+        if (worker->own_loader != nullptr)
+            worker->loader->addListener(loaderListener);
+    }
 }
 
 void TickLoader::addListener(DxApi::TickLoader::SubscriptionListener *listener) {
@@ -129,6 +966,10 @@ void TickLoader::removeListener(DxApi::TickLoader::ErrorListener *listener) {
     LoaderErrorListener * loaderListener = errorListeners_[listener];
     if (loaderListener != 0) {
         loader_->removeListener(loaderListener);
+        for (std::unique_ptr<LoaderWorker> &worker : workers_) {
+            if (worker->own_loader != nullptr)
+                worker->loader->removeListener(loaderListener);
+        }
         errorListeners_.erase(listener);
         removedListeners_.push_back(loaderListener);
     }
@@ -146,9 +987,49 @@ size_t TickLoader::nSubscriptionListeners() {
     return loader_->nSubscriptionListeners();
 }
 
-int32_t TickLoader::getTypeId(PyObject *message) {
+// header properties of message, like message-level getters of python_common
+static bool getHeaderString(PyObject *object, const std::string &field_name, std::string &ret_value) {
+    bool type_mismatch = false;
+    bool not_null = getStringValue(object, ret_value, type_mismatch);
+    if (type_mismatch)
+        THROW_EXCEPTION("Wrong type of field '%s'. Required: STRING.", field_name.c_str());
+
+    return not_null;
+}
+
+static bool getHeaderInt32(AttributeAccessor &message, HeaderProperty property,
+    const std::string &field_name, int32_t &ret_value)
+{
+    PythonRefHolder object(message.get(property));
+    if (object.getReference() == NULL || object.getReference() == Py_None)
+        return false;
+
+    bool type_mismatch = false;
+    bool not_null = getInt32Value(object.getReference(), ret_value, type_mismatch);
+    if (type_mismatch)
+        THROW_EXCEPTION("Wrong type of field '%s'. Required: INTEGER.", field_name.c_str());
+
+    return not_null;
+}
+
+static bool getHeaderInt64(AttributeAccessor &message, HeaderProperty property,
+    const std::string &field_name, int64_t &ret_value)
+{
+    PythonRefHolder object(message.get(property));
+    if (object.getReference() == NULL || object.getReference() == Py_None)
+        return false;
+
+    bool type_mismatch = false;
+    bool not_null = getInt64Value(object.getReference(), ret_value, type_mismatch);
+    if (type_mismatch)
+        THROW_EXCEPTION("Wrong type of field '%s'. Required: INTEGER.", field_name.c_str());
+
+    return not_null;
+}
+
+int32_t TickLoader::getTypeId(AttributeAccessor &message) {
     int32_t type_id;
-    bool exists = getInt32Value(message, TYPE_ID_PROPERTY, TYPE_ID_PROPERTY1, type_id);
+    bool exists = getHeaderInt32(message, TYPE_ID_HEADER, TYPE_ID_PROPERTY, type_id);
     if (!exists) {
         type_id = getStrTypeId(message);
         if (type_id == INT32_MIN)
@@ -158,18 +1039,27 @@ int32_t TickLoader::getTypeId(PyObject *message) {
     return type_id;
 }
 
-int32_t TickLoader::getStrTypeId(PyObject *message) {
+int32_t TickLoader::getStrTypeId(AttributeAccessor &message) {
+    PythonRefHolder object(message.get(TYPE_NAME_HEADER));
+    if (object.getReference() == NULL || object.getReference() == Py_None)
+        return INT32_MIN;
+
+    int32_t type_id;
+    if (findCachedId(type_name_ids_, object.getReference(), type_id))
+        return type_id;
+
     std::string type_name;
-    bool exists = getStringValue(message, TYPE_NAME_PROPERTY, TYPE_NAME_PROPERTY1, type_name);
-    if (!exists)
+    if (!getHeaderString(object.getReference(), TYPE_NAME_PROPERTY, type_name))
         return INT32_MIN;
 
-    return registerType(type_name);
+    type_id = registerType(type_name);
+    cacheId(type_name_ids_, object.getReference(), type_id);
+    return type_id;
 }
 
-int32_t TickLoader::getInstrumentId(PyObject *message) {
+int32_t TickLoader::getInstrumentId(AttributeAccessor &message) {
     int32_t instrument_id;
-    bool exists = getInt32Value(message, INSTRUMENT_ID_PROPERTY, INSTRUMENT_ID_PROPERTY1, instrument_id);
+    bool exists = getHeaderInt32(message, INSTRUMENT_ID_HEADER, INSTRUMENT_ID_PROPERTY, instrument_id);
     if (!exists) {
         instrument_id = getStrInstrumentId(message);
         if (instrument_id == INT32_MIN)
@@ -179,15 +1069,31 @@ int32_t TickLoader::getInstrumentId(PyObject *message) {
     return instrument_id;
 }
 
-int32_t TickLoader::getStrInstrumentId(PyObject *message) {
+int32_t TickLoader::getStrInstrumentId(AttributeAccessor &message) {
+    PythonRefHolder object(message.get(SYMBOL_HEADER));
+    if (object.getReference() == NULL || object.getReference() == Py_None)
+        return INT32_MIN;
+
+    int32_t instrument_id;
+    if (findCachedId(symbol_ids_, object.getReference(), instrument_id))
+        return instrument_id;
+
     std::string symbol;
-    bool exists = getStringValue(message, SYMBOL_PROPERTY, SYMBOL_PROPERTY1, symbol);
-    if (!exists)
+    if (!getHeaderString(object.getReference(), SYMBOL_PROPERTY, symbol))
         return INT32_MIN;
 
     if (symbol.empty())
         THROW_EXCEPTION("Symbol is empty. Specify '%s' attribute for message.", SYMBOL_PROPERTY.c_str());
 
+    instrument_id = getSymbolId(symbol);
+    cacheId(symbol_ids_, object.getReference(), instrument_id);
+    return instrument_id;
+}
+
+int32_t TickLoader::getSymbolId(const std::string &symbol) {
+    if (symbol.empty())
+        THROW("Symbol is empty.");
+
     auto it = symbol_to_id_.find(symbol);
     if (it != symbol_to_id_.end())
         return it->second;
@@ -197,18 +1103,50 @@ int32_t TickLoader::getStrInstrumentId(PyObject *message) {
     return id;
 }
 
-DxApi::TimestampMs TickLoader::getTimestamp(PyObject *message) {
+DxApi::TimestampMs TickLoader::getTimestamp(AttributeAccessor &message) {
     int64_t ret_value;
-    bool ok = getInt64Value(message, TIMESTAMP_PROPERTY, TIMESTAMP_PROPERTY1, ret_value);
+    bool ok = getHeaderInt64(message, TIMESTAMP_HEADER, TIMESTAMP_PROPERTY, ret_value);
     if (!ok)
         return DxApi::TIMESTAMP_UNKNOWN;
 
     return ret_value;
 }
 
+bool TickLoader::findCachedId(const StringIdCache &cache, PyObject *string, int32_t &id) {
+    auto it = cache.find(string);
+    if (it == cache.end())
+        return false;
+
+    id = it->second;
+    return true;
+}
+
+void TickLoader::cacheId(StringIdCache &cache, PyObject *string, int32_t id) {
+    // only exact strings are immutable, subclasses may be mutable or compare differently
+#if PY_MAJOR_VERSION >= 3
+    if (!PyUnicode_CheckExact(string))
+#else
+    if (!PyString_CheckExact(string))
+#endif
+        return;
+
+    if (cache.size() >= MAX_CACHED_STRINGS)
+        clearCachedIds(cache);
+
+    Py_INCREF(string);
+    cache[string] = id;
+}
+
+void TickLoader::clearCachedIds(StringIdCache &cache) {
+    for (auto &entry : cache)
+        Py_DECREF(entry.first);
+    cache.clear();
+}
+
 int32_t TickLoader::findDescriptor(const std::string &name) {
-    for (int i = 0; i < descriptors_.size(); ++i) {
-        if (descriptors_[i].className == name) {
+    const std::vector<Schema::TickDbClassDescriptor> &descriptors = schema_->descriptors;
+    for (int i = 0; i < descriptors.size(); ++i) {
+        if (descriptors[i].className == name) {
             return i;
         }
     }
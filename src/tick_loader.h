@@ -15,6 +15,12 @@ namespace TbApiImpl {
 namespace Python {
 
 class MessageCodec;
+class AttributeReader;
+class AttributeAccessor;
+class ColumnSource;
+struct CachedSchema;
+struct LoaderWorker;
+struct AsyncQueue;
 
 class LoaderErrorListener : public DxApi::TickLoader::ErrorListener {
 private:
@@ -50,6 +56,22 @@ public:
     uint32_t registerInstrument(const std::string &instrument);
 
     void send(PyObject *message);
+    size_t sendBatch(PyObject *messages);
+
+    // returns dict with native send, sendBatch and flush methods, which are bound to owner (python loader)
+    PyObject * fastMethods(PyObject *owner);
+    size_t sendColumns(const std::string &type_name, PyObject *symbols, PyObject *timestamps, PyObject *columns);
+
+    // sendColumns encodes messages by given number of loaders of stream in parallel threads,
+    // symbols are distributed between loaders, messages of every symbol are sent by one loader in order
+    void setWorkers(size_t workers, const DxApi::LoadingOptions &options);
+
+    // send and sendBatch put messages to queue of given size, background thread encodes, sends
+    // and flushes them every flush_period_ms (0 - only by flush), queue_size 0 stops background thread
+    void setAsync(size_t queue_size, bool drop_on_overflow, int32_t flush_period_ms);
+
+    // number of messages, which are dropped on overflow of queue
+    size_t nDroppedMessages();
     void flush();
     void close();
 
@@ -67,11 +89,30 @@ private:
 
     int32_t findDescriptor(const std::string &name);
 
-    int32_t getTypeId(PyObject *message);
-    int32_t getStrTypeId(PyObject *message);
-    int32_t getInstrumentId(PyObject *message);
-    int32_t getStrInstrumentId(PyObject *message);
-    DxApi::TimestampMs getTimestamp(PyObject *message);
+    int32_t getTypeId(AttributeAccessor &message);
+    int32_t getStrTypeId(AttributeAccessor &message);
+    int32_t getInstrumentId(AttributeAccessor &message);
+    int32_t getStrInstrumentId(AttributeAccessor &message);
+    int32_t getSymbolId(const std::string &symbol);
+
+    size_t sendColumnsParallel(const std::string &type_name, uint32_t type_id, const std::string *symbol, const ColumnSource *symbol_source,
+        const ColumnSource &timestamp_source, const std::vector<const ColumnSource *> &sources, size_t size);
+    LoaderWorker & getSymbolWorker(const std::string &symbol, int32_t &instrument_id);
+    void closeWorkers();
+
+    void sendAsync(uint32_t type_id, int32_t instrument_id, DxApi::TimestampMs timestamp, PyObject *values);
+    void runAsync(std::shared_ptr<AsyncQueue> queue);
+    void flushAsync();
+
+    // returns the last error of background thread, which isn't raised yet
+    std::string stopAsync();
+
+    typedef std::unordered_map<PyObject *, int32_t> StringIdCache;
+
+    static bool findCachedId(const StringIdCache &cache, PyObject *string, int32_t &id);
+    static void cacheId(StringIdCache &cache, PyObject *string, int32_t id);
+    static void clearCachedIds(StringIdCache &cache);
+    DxApi::TimestampMs getTimestamp(AttributeAccessor &message);
 
     void clearListeners();
     void freeListeners();
@@ -79,17 +120,36 @@ private:
     uint32_t next_id_ = 0;
     std::unordered_map<std::string, uint32_t> type_to_id_;
     std::unordered_map<std::string, uint32_t> symbol_to_id_;
+
+    // ids of type names and symbols by identity of python strings, which are reused by messages,
+    // strings are referenced by cache, so their addresses are not reused
+    StringIdCache type_name_ids_;
+    StringIdCache symbol_ids_;
     std::vector<std::shared_ptr<MessageCodec>> message_codecs_;
 
-    std::vector<Schema::TickDbClassDescriptor> descriptors_;
+    std::shared_ptr<CachedSchema> schema_;
     std::unique_ptr<DxApi::TickLoader> loader_;
 
+    // loaders of parallel sendColumns, the first worker uses loader_, empty if workers are not set
+    std::vector<std::unique_ptr<LoaderWorker>> workers_;
+
+    // queue of asynchronous sending, NULL if messages are sent by calling thread;
+    // sending threads and background thread share the queue, so it outlives concurrent close
+    std::shared_ptr<AsyncQueue> async_;
+
+    // guards loader_, which sends and flushes messages without GIL,
+    // so other python threads and background thread of async_ can use loader meanwhile
+    std::mutex loader_lock_;
+
     PyObject *  TYPE_ID_PROPERTY1 = PyUnicode_FromString("typeId");
     PyObject *  TYPE_NAME_PROPERTY1 = PyUnicode_FromString("typeName");
     PyObject *  INSTRUMENT_ID_PROPERTY1 = PyUnicode_FromString("instrumentId");
     PyObject *  SYMBOL_PROPERTY1 = PyUnicode_FromString("symbol");
     PyObject *  TIMESTAMP_PROPERTY1 = PyUnicode_FromString("timestamp");
 
+    // reads header properties above with plan of python class of message
+    std::unique_ptr<AttributeReader> header_reader_;
+
     std::unordered_map<DxApi::TickLoader::ErrorListener *, LoaderErrorListener *> errorListeners_;
     std::mutex errorListenerLock_;
     std::vector<LoaderErrorListener *> removedListeners_;
@@ -1,6 +1,7 @@
 import unittest
 import servertest
 import testutils
+import copy
 import tbapi
 
 class CursorTest(servertest.TestWithStreams):
@@ -179,6 +180,256 @@ class CursorTest(servertest.TestWithStreams):
             elif "BarMessage" in typeName:
                 self.assertEqual(stream, "bars1min")
 
+    def test_HeaderObjectsCached(self):
+        barStream = self.db.getStream(self.streamKeys[0])
+        with barStream.trySelect(0, tbapi.SelectionOptions(), None, None) as cursor:
+            symbols = {}
+            for i in range(100):
+                self.assertTrue(cursor.next())
+                message = cursor.getMessage()
+                symbol = symbols.setdefault(message.symbol, message.symbol)
+                self.assertIs(message.symbol, symbol)
+
+            cursor.clearAllEntities()
+            cursor.addEntities([self.entities['AAPL']])
+            cursor.reset(0)
+            self.assertTrue(cursor.next())
+            self.assertEqual(cursor.getMessage().symbol, 'AAPL')
+
+    def test_CodecsSharedByCursors(self):
+        barStream = self.db.getStream(self.streamKeys[0])
+        for i in range(10):
+            with barStream.trySelect(0, tbapi.SelectionOptions(), None, None) as cursor:
+                self.assertTrue(cursor.next())
+
+        # cached codecs are not shared by cursors, which are read at the same time
+        with barStream.trySelect(0, tbapi.SelectionOptions(), None, None) as cursor1:
+            with barStream.trySelect(0, tbapi.SelectionOptions(), None, None) as cursor2:
+                cursor2.setFields(['close'])
+                for i in range(100):
+                    self.assertTrue(cursor1.next())
+                    self.assertTrue(cursor2.next())
+                    message1 = cursor1.getMessage()
+                    message2 = cursor2.getMessage()
+                    self.assertEqual(message1.timestamp, message2.timestamp)
+                    self.assertEqual(message1.close, message2.close)
+                    self.assertTrue(hasattr(message1, 'open'))
+                    self.assertFalse(hasattr(message2, 'open'))
+
+    def test_Iterator(self):
+        barStream = self.db.getStream(self.streamKeys[0])
+        messages = self.readMessages(barStream, 0, 9000)
+
+        with barStream.trySelect(0, tbapi.SelectionOptions(), None, None) as cursor:
+            count = 0
+            for message in cursor:
+                if count < len(messages):
+                    self.assertEqual(message.timestamp, messages[count].timestamp)
+                    self.assertEqual(message.symbol, messages[count].symbol)
+                    self.assertAlmostEqual(message.close, messages[count].close)
+                count += 1
+            self.assertEqual(count, 10000)
+            self.assertTrue(cursor.isAtEnd())
+            self.assertEqual(len(list(cursor)), 0)
+
+            # iterators are created only by cursors
+            with self.assertRaises(TypeError):
+                type(iter(cursor))()
+
+    def test_TypedMessages(self):
+        barStream = self.db.getStream(self.streamKeys[0])
+        messages = self.readMessages(barStream, 0, 100)
+
+        with barStream.trySelect(0, tbapi.SelectionOptions(), None, None) as cursor:
+            cursor.setTypedMessages(True)
+            for i in range(len(messages)):
+                self.assertTrue(cursor.next())
+                message = cursor.getMessage()
+                self.assertIsInstance(message, tbapi.TypedInstrumentMessage)
+                self.assertNotIn('close', vars(message))
+                self.assertEqual(message.timestamp, messages[i].timestamp)
+                self.assertEqual(message.symbol, messages[i].symbol)
+                self.assertEqual(message.typeName, messages[i].typeName)
+                self.assertAlmostEqual(message.close, messages[i].close)
+                self.assertIn('close', str(message))
+
+            copied = copy.deepcopy(message)
+            self.assertIs(type(copied), type(message))
+            self.assertEqual(copied.close, message.close)
+
+            cursor.setTypedMessages(False)
+            self.assertTrue(cursor.next())
+            self.assertIn('close', vars(cursor.getMessage()))
+
+    def test_NextBatch(self):
+        barStream = self.db.getStream(self.streamKeys[0])
+        messages = self.readMessages(barStream, 0, 9000)
+
+        with barStream.trySelect(0, tbapi.SelectionOptions(), None, None) as cursor:
+            batch = cursor.nextBatch(3000)
+            self.assertEqual(len(batch), 3000)
+
+            timestamps = batch.decode('timestamp')
+            symbols = batch.decode('symbol')
+            typeNames = batch.decode('typeName')
+            closes = batch.decode('close')
+            for i in range(len(messages)):
+                self.assertEqual(timestamps[i], messages[i].timestamp)
+                self.assertEqual(symbols[i], messages[i].symbol)
+                self.assertEqual(typeNames[i], messages[i].typeName)
+                self.assertAlmostEqual(closes[i], messages[i].close)
+
+            count = len(batch)
+            while len(batch) > 0:
+                batch = cursor.nextBatch(3000)
+                count += len(batch)
+            self.assertEqual(count, 10000)
+
+    def test_Prefetch(self):
+        barStream = self.db.getStream(self.streamKeys[0])
+        messages = self.readMessages(barStream, 0, 9000)
+
+        with barStream.trySelect(0, tbapi.SelectionOptions(), None, None) as cursor:
+            cursor.setPrefetch(4, 1000)
+            with self.assertRaises(Exception):
+                cursor.next()
+            with self.assertRaises(Exception):
+                cursor.getMessage()
+
+            batch = cursor.nextBatch()
+            self.assertEqual(len(batch), 1000)
+            timestamps = batch.decode('timestamp')
+            closes = batch.decode('close')
+            for i in range(len(batch)):
+                self.assertEqual(timestamps[i], messages[i].timestamp)
+                self.assertAlmostEqual(closes[i], messages[i].close)
+
+            count = len(batch)
+            while not cursor.isAtEnd():
+                count += len(cursor.nextBatch())
+            self.assertEqual(count, 10000)
+            self.assertEqual(len(cursor.nextBatch()), 0)
+
+            # reset restarts prefetching from the new position
+            cursor.reset(0)
+            self.assertEqual(len(cursor.nextArrowBatch()), 1000)
+
+            cursor.setPrefetch(0)
+            self.assertTrue(cursor.next())
+
+        # live cursors wait for data, they are not prefetched
+        options = tbapi.SelectionOptions()
+        options.live = True
+        with barStream.trySelect(0, options, None, None) as cursor:
+            with self.assertRaises(Exception):
+                cursor.setPrefetch(4, 1000)
+            self.assertTrue(cursor.next())
+
+    def test_NextBatchPolymorphic(self):
+        tradeBBOStream = self.db.getStream(self.streamKeys[1])
+        with tradeBBOStream.trySelect(0, tbapi.SelectionOptions(), None, None) as cursor:
+            batch = cursor.nextBatch(100)
+            self.assertEqual(len(batch), 100)
+
+            typeNames = batch.decode('typeName')
+            prices = batch.decode('price')
+            for i in range(len(batch)):
+                if typeNames[i] == self.types['trade']:
+                    self.assertIsNotNone(prices[i])
+                else:
+                    self.assertIsNone(prices[i])
+
+    def test_SetFields(self):
+        barStream = self.db.getStream(self.streamKeys[0])
+        messages = self.readMessages(barStream, 0, 100)
+
+        with barStream.trySelect(0, tbapi.SelectionOptions(), None, None) as cursor:
+            cursor.setFields(['close'])
+            for expected in messages:
+                self.assertTrue(cursor.next())
+                message = cursor.getMessage()
+                self.assertEqual(message.timestamp, expected.timestamp)
+                self.assertEqual(message.symbol, expected.symbol)
+                self.assertAlmostEqual(message.close, expected.close)
+                self.assertFalse(hasattr(message, 'open'))
+
+            batch = cursor.nextBatch(100)
+            self.assertEqual(set(batch.keys()), set(['timestamp', 'symbol', 'typeId', 'typeName', 'close']))
+
+            cursor.setFields(None)
+            self.assertTrue(cursor.next())
+            self.assertTrue(hasattr(cursor.getMessage(), 'open'))
+
+    def test_LazyMessages(self):
+        barStream = self.db.getStream(self.streamKeys[0])
+        messages = self.readMessages(barStream, 0, 100)
+
+        with barStream.trySelect(0, tbapi.SelectionOptions(), None, None) as cursor:
+            cursor.setLazyMessages(True)
+            lazyMessages = []
+            for expected in messages:
+                self.assertTrue(cursor.next())
+                message = cursor.getMessage()
+                self.assertIsInstance(message, tbapi.LazyInstrumentMessage)
+                self.assertIs(message, cursor.getMessage())
+                self.assertEqual(message.symbol, expected.symbol)
+                lazyMessages.append(message)
+
+            for i in range(len(messages)):
+                self.assertEqual(lazyMessages[i].timestamp, messages[i].timestamp)
+                self.assertEqual(lazyMessages[i].typeId, messages[i].typeId)
+                self.assertEqual(lazyMessages[i].typeName, messages[i].typeName)
+                self.assertAlmostEqual(lazyMessages[i].close, messages[i].close)
+                self.assertFalse(hasattr(lazyMessages[i], 'unknownField'))
+
+    def test_ReadColumns(self):
+        tradeBBOStream = self.db.getStream(self.streamKeys[1])
+        with tradeBBOStream.trySelect(0, tbapi.SelectionOptions(), None, None) as cursor:
+            batch = cursor.readColumns(['timestamp', 'typeName', 'price'])
+            self.assertEqual(len(batch), 10000)
+            self.assertEqual(set(batch.keys()), set(['timestamp', 'symbol', 'typeId', 'typeName', 'price']))
+
+        table = tbapi.stream_to_columns(self.db, tradeBBOStream, ['typeName', 'price'])
+        self.assertEqual(len(table['price']), 10000)
+        for i in range(len(table['price'])):
+            if table['typeName'][i] == self.types['trade']:
+                self.assertFalse(table['price'][i] != table['price'][i])
+            else:
+                self.assertTrue(table['price'][i] is None or table['price'][i] != table['price'][i])
+
+    def test_StreamToDictKeys(self):
+        tradeBBOStream = self.db.getStream(self.streamKeys[1])
+
+        # rows of stream_to_dict were built from vars() of messages
+        keys = set()
+        typeIds = []
+        with tradeBBOStream.trySelect(0, tbapi.SelectionOptions(), None, None) as cursor:
+            while cursor.next():
+                message = cursor.getMessage()
+                keys.update(vars(message).keys())
+                typeIds.append(message.typeId)
+
+        table = tbapi.stream_to_dict(self.db, tradeBBOStream)
+        self.assertEqual(set(table.keys()), keys)
+        self.assertEqual(list(table['typeId']), typeIds)
+
+        table = tbapi.stream_to_dict(self.db, tradeBBOStream, ['price'])
+        self.assertEqual(set(table.keys()), set(['timestamp', 'symbol', 'typeId', 'typeName', 'price']))
+
+    def test_NextArrowBatch(self):
+        try:
+            import pyarrow
+        except ImportError:
+            self.skipTest('pyarrow is not installed')
+
+        barStream = self.db.getStream(self.streamKeys[0])
+        messages = self.readMessages(barStream, 0, 99)
+        with barStream.trySelect(0, tbapi.SelectionOptions(), None, None) as cursor:
+            records = cursor.nextArrowBatch(100).toPyArrow()
+            self.assertEqual(records.num_rows, 100)
+            self.assertEqual(records.column('symbol').to_pylist(), [m.symbol for m in messages])
+            self.assertEqual(records.column('close').to_pylist(), [m.close for m in messages])
+
     def test_ContextManager(self):
         stream = self.db.getStream(self.streamKeys[0])
 
@@ -3,6 +3,9 @@ import servertest
 import generators
 import time
 import random
+import decimal
+import copy
+import array
 import tbapi
 
 class TestLoadData(servertest.TBServerTest):
@@ -14,6 +17,26 @@ class TestLoadData(servertest.TBServerTest):
     def isclose(self, a, b, rel_tol=1e-09, abs_tol=0.0):
         return abs(a-b) <= max(rel_tol * max(abs(a), abs(b)), abs_tol)
 
+    def newSimpleTypesMessage(self):
+        message = tbapi.InstrumentMessage()
+        message.symbol = "AAA"
+        message.instrumentType = 'EQUITY'
+        message.typeName = 'deltix.qsrv.test.messages.AllSimpleTypesMessage'
+        message.asciiTextField = 'asciiText'
+        message.binaryField = bytearray([10,20,30])
+        message.boolField = True
+        message.byteField = 42
+        message.doubleField = 43.43
+        message.enumField = 'THREE'
+        message.floatField = 44.44
+        message.intField = 1234
+        message.longField = 12345
+        message.shortField = 123
+        message.textField = 'text'
+        message.timeOfDayField = 2
+        message.timestampField = 123456
+        return message
+
     def test_LoadNulls(self):
         key = 'alltypes'
         try:
@@ -146,5 +169,256 @@ class TestLoadData(servertest.TBServerTest):
         finally:
             self.deleteStream(key)
 
+    def test_LoadUnicodeVarchar(self):
+        key = self.streamKeys[1]
+        try:
+            stream = self.createStream(key, True)
+            self.assertIsNotNone(stream)
+
+            conditions = ['', 'Hello', 'Grüße', 'Привет €', '日本語 \U0001F600']
+            with stream.tryLoader(tbapi.LoadingOptions()) as loader:
+                tradeGenerator = generators.TradeGenerator(0, 1000000000, len(conditions), ['MSFT', 'ORCL'])
+                loadCount = 0
+                while tradeGenerator.next():
+                    tradeMessage = tradeGenerator.getMessage()
+                    tradeMessage.condition = conditions[loadCount]
+                    loader.send(tradeMessage)
+                    loadCount = loadCount + 1
+
+            with stream.trySelect(0, tbapi.SelectionOptions(), None, None) as cursor:
+                readCount = 0
+                while cursor.next():
+                    self.assertEqual(conditions[readCount], cursor.getMessage().condition)
+                    readCount = readCount + 1
+                self.assertEqual(len(conditions), readCount)
+        finally:
+            self.deleteStream(key)
+
+    def test_LoadWrongStrings(self):
+        key = 'alltypes'
+        try:
+            stream = self.createStreamQQL(key)
+            self.assertIsNotNone(stream)
+
+            with stream.tryLoader(tbapi.LoadingOptions()) as loader:
+                message = self.newSimpleTypesMessage()
+                message.asciiTextField = 'Grüße'
+                with self.assertRaises(Exception):
+                    loader.send(message)
+
+                message = self.newSimpleTypesMessage()
+                message.textField = 42
+                with self.assertRaises(Exception):
+                    loader.send(message)
+        finally:
+            self.deleteStream(key)
+
+    def test_LoadDecimals(self):
+        key = 'alltypes'
+        try:
+            stream = self.createStreamQQL(key)
+            self.assertIsNotNone(stream)
+
+            decimals = [0.0, 42.42, -42.42, 0.0000001, 123456789.123, -0.5, 1e20, 3.14159265358979, 1e-30]
+            with stream.tryLoader(tbapi.LoadingOptions()) as loader:
+                message = self.newSimpleTypesMessage()
+                for i in range(len(decimals)):
+                    message.decimalField = decimals[i]
+                    message.decimalNullableField = None if i % 2 == 0 else decimals[i]
+                    loader.send(message)
+
+            with stream.trySelect(0, tbapi.SelectionOptions(), None, None) as cursor:
+                messages = []
+                while cursor.next():
+                    messages.append(copy.deepcopy(cursor.getMessage()))
+            self.assertEqual(len(decimals), len(messages))
+
+            with stream.trySelect(0, tbapi.SelectionOptions(), None, None) as cursor:
+                batch = cursor.nextBatch(100)
+                values = batch.decode('decimalField')
+                nullableValues = batch.decode('decimalNullableField')
+
+            for i in range(len(decimals)):
+                self.assertTrue(self.isclose(messages[i].decimalField, decimals[i]))
+                self.assertEqual(values[i], messages[i].decimalField)
+                if i % 2 == 0:
+                    self.assertIsNone(nullableValues[i])
+                else:
+                    self.assertEqual(nullableValues[i], messages[i].decimalNullableField)
+        finally:
+            self.deleteStream(key)
+
+    def test_DecimalModes(self):
+        key = 'alltypes'
+        try:
+            stream = self.createStreamQQL(key)
+            self.assertIsNotNone(stream)
+
+            decimals = ['42.42', '-0.125', '1234567.891', '0.005']
+            with stream.tryLoader(tbapi.LoadingOptions()) as loader:
+                message = self.newSimpleTypesMessage()
+                for value in decimals:
+                    message.decimalField = float(value)
+                    message.decimalNullableField = None
+                    loader.send(message)
+
+            with stream.trySelect(0, tbapi.SelectionOptions(), None, None) as cursor:
+                cursor.setDecimalMode('decimal')
+                self.assertTrue(cursor.next())
+                self.assertEqual(cursor.getMessage().decimalField, decimal.Decimal('42.42'))
+                self.assertIsNone(cursor.getMessage().decimalNullableField)
+
+                batch = cursor.nextBatch(100)
+                self.assertEqual(batch.decode('decimalField'), [decimal.Decimal(value) for value in decimals[1:]])
+
+            with stream.trySelect(0, tbapi.SelectionOptions(), None, None) as cursor:
+                cursor.setDecimalMode('fixed', 2, { 'decimalNullableField': 4 })
+                batch = cursor.nextBatch(100)
+                self.assertEqual(list(batch.decode('decimalField')), [4242, -12, 123456789, 0])
+                self.assertEqual(list(batch.decode('decimalNullableField')), [None] * len(decimals))
+
+            with stream.trySelect(0, tbapi.SelectionOptions(), None, None) as cursor:
+                cursor.setDecimalMode('raw')
+                self.assertTrue(cursor.next())
+                raw = cursor.getMessage().decimalField
+                self.assertIsInstance(raw, int)
+
+                cursor.setDecimalMode('float')
+                self.assertTrue(cursor.next())
+                self.assertTrue(self.isclose(cursor.getMessage().decimalField, -0.125))
+
+                with self.assertRaises(Exception):
+                    cursor.setDecimalMode('double')
+        finally:
+            self.deleteStream(key)
+
+    def test_TypedArrays(self):
+        key = 'alltypes'
+        try:
+            stream = self.createStreamQQL(key)
+            self.assertIsNotNone(stream)
+
+            with stream.tryLoader(tbapi.LoadingOptions()) as loader:
+                message = tbapi.InstrumentMessage()
+                message.symbol = "AAA"
+                message.instrumentType = 'EQUITY'
+                message.typeName = 'deltix.qsrv.test.messages.AllListsMessage'
+                message.nestedDoubleList = array.array('d', [1.5, 2.5, float('nan')])
+                message.nestedLongList = memoryview(array.array('q', [1, 2, 3]))
+                message.nestedIntList = [1, None, 3]
+                message.nestedDecimalList = (42.42, -1.25)
+                message.nestedBooleanList = [True, False]
+                loader.send(message)
+
+                # bytes and buffers of other types are not arrays of elements
+                invalid = tbapi.InstrumentMessage()
+                invalid.symbol = "AAA"
+                invalid.instrumentType = 'EQUITY'
+                invalid.typeName = 'deltix.qsrv.test.messages.AllListsMessage'
+                for value in [b'\x01\x02', bytearray(b'\x01'), 'abc']:
+                    invalid.nestedByteList = value
+                    with self.assertRaises(Exception):
+                        loader.send(invalid)
+                invalid.nestedByteList = None
+                invalid.nestedLongList = array.array('d', [1.5])
+                with self.assertRaises(Exception):
+                    loader.send(invalid)
+
+            with stream.trySelect(0, tbapi.SelectionOptions(), None, None) as cursor:
+                cursor.setTypedArrays(True)
+                self.assertTrue(cursor.next())
+                message = cursor.getMessage()
+
+                self.assertIsInstance(message.nestedDoubleList, memoryview)
+                self.assertEqual(message.nestedDoubleList.format, 'd')
+                self.assertEqual(message.nestedDoubleList.tolist()[:2], [1.5, 2.5])
+                self.assertNotEqual(message.nestedDoubleList[2], message.nestedDoubleList[2])
+                self.assertEqual(message.nestedLongList.format, 'q')
+                self.assertEqual(message.nestedLongList.tolist(), [1, 2, 3])
+                self.assertEqual(message.nestedIntList, [1, None, 3])
+                self.assertTrue(self.isclose(message.nestedDecimalList[0], 42.42))
+                self.assertEqual(message.nestedBooleanList.tolist(), [True, False])
+                self.assertIsNone(message.nestedShortList)
+
+                cursor.setTypedArrays(False)
+                cursor.reset(0)
+                self.assertTrue(cursor.next())
+                self.assertEqual(cursor.getMessage().nestedLongList, [1, 2, 3])
+        finally:
+            self.deleteStream(key)
+
+    def test_ArrowLists(self):
+        try:
+            import pyarrow
+        except ImportError:
+            self.skipTest('pyarrow is not installed')
+
+        key = 'alltypes'
+        try:
+            stream = self.createStreamQQL(key)
+            self.assertIsNotNone(stream)
+
+            with stream.tryLoader(tbapi.LoadingOptions()) as loader:
+                message = tbapi.InstrumentMessage()
+                message.symbol = "AAA"
+                message.instrumentType = 'EQUITY'
+                message.typeName = 'deltix.qsrv.test.messages.AllListsMessage'
+                message.nestedDoubleList = [1.5, 2.5]
+                message.nestedIntList = [1, None, 3]
+                message.nestedAsciiTextList = ['a', 'b']
+                loader.send(message)
+                message.nestedDoubleList = None
+                message.nestedIntList = []
+                loader.send(message)
+
+            with stream.trySelect(0, tbapi.SelectionOptions(), None, None) as cursor:
+                records = pyarrow.record_batch(cursor.nextArrowBatch(100))
+                self.assertEqual(records.num_rows, 2)
+                self.assertEqual(records.column('nestedDoubleList').to_pylist(), [[1.5, 2.5], None])
+                self.assertEqual(records.column('nestedIntList').to_pylist(), [[1, None, 3], []])
+                self.assertEqual(records.column('nestedAsciiTextList').to_pylist(), [['a', 'b'], ['a', 'b']])
+                self.assertFalse('nestedObjectsList' in records.schema.names)
+
+            with stream.trySelect(0, tbapi.SelectionOptions(), None, None) as cursor:
+                batch = cursor.nextBatch(100)
+                self.assertEqual(batch.decode('nestedDoubleList'), [[1.5, 2.5], None])
+                self.assertEqual(batch.decode('nestedIntList'), [[1, None, 3], []])
+        finally:
+            self.deleteStream(key)
+
+    def test_BinaryViews(self):
+        key = 'alltypes'
+        try:
+            stream = self.createStreamQQL(key)
+            self.assertIsNotNone(stream)
+
+            payloads = [bytes(range(256)) * 4, b'', b'xyz']
+            with stream.tryLoader(tbapi.LoadingOptions()) as loader:
+                message = self.newSimpleTypesMessage()
+                for payload in payloads:
+                    message.binaryField = memoryview(payload)
+                    message.binaryNullableField = array.array('B', payload) if payload else None
+                    loader.send(message)
+
+            with stream.trySelect(0, tbapi.SelectionOptions(), None, None) as cursor:
+                cursor.setBinaryViews(True)
+                views = []
+                while cursor.next():
+                    message = cursor.getMessage()
+                    self.assertIsInstance(message.binaryField, memoryview)
+                    self.assertTrue(message.binaryField.readonly)
+                    views.append(message.binaryField)
+                    with self.assertRaises(TypeError):
+                        type(message.binaryField.obj)()
+                    if len(views) == 2:
+                        self.assertIsNone(message.binaryNullableField)
+                    else:
+                        self.assertEqual(bytes(message.binaryNullableField), payloads[len(views) - 1])
+
+                # memoryviews, which are kept, are not overwritten by next messages
+                self.assertEqual([bytes(view) for view in views], payloads)
+        finally:
+            self.deleteStream(key)
+
 if __name__ == '__main__':
     unittest.main()
@@ -1,7 +1,11 @@
 import unittest
+import array
+import dataclasses
 import servertest
 import testutils, generators
 import time
+import threading
+import types
 import tbapi
 
 
@@ -209,6 +213,393 @@ class TestLoader(servertest.TBServerTest):
                 loader.close()
             self.deleteStream(key)
 
+    def test_FastMethods(self):
+        key = self.streamKeys[0]
+        stream = self.createStreamQQL(key)
+        loader = stream.createLoader(tbapi.LoadingOptions())
+        try:
+            count = 1000
+            barGenerator = generators.BarGenerator(0, 1000000000, count, ['EPAM'])
+            while barGenerator.next():
+                loader.send(barGenerator.getMessage())
+            loader.flush()
+            self.assertIsInstance(loader.send, types.BuiltinFunctionType)
+            self.assertIsInstance(loader.flush, types.BuiltinFunctionType)
+
+            send = loader.send
+            loader.close()
+            loader = None
+            self.assertEqual(count, self.streamCount(key))
+            with self.assertRaises(Exception):
+                send(barGenerator.getMessage())
+        finally:
+            if loader != None:
+                loader.close()
+            self.deleteStream(key)
+
+    def test_SendBatch(self):
+        key = self.streamKeys[1]
+        stream = self.createStreamQQL(key)
+        loader = stream.createLoader(tbapi.LoadingOptions())
+        try:
+            count = 1000
+            tradeGenerator = generators.TradeGenerator(0, 1000000000, count, ['MSFT', 'ORCL'])
+            bboGenerator = generators.BBOGenerator(0, 1000000000, count, ['MSFT', 'ORCL'])
+            batch = []
+            while True:
+                tradeGenerator.message = tbapi.InstrumentMessage()
+                bboGenerator.message = tbapi.InstrumentMessage()
+                if not (tradeGenerator.next() and bboGenerator.next()):
+                    break
+                batch.append(tradeGenerator.getMessage())
+                batch.append(bboGenerator.getMessage())
+
+            self.assertEqual(count * 2, loader.sendBatch(batch))
+            self.assertEqual(0, loader.sendBatch([]))
+
+            message = tbapi.InstrumentMessage()
+            message.symbol = 'MSFT'
+            message.typeName = 'unknown.Type'
+            with self.assertRaises(Exception):
+                loader.sendBatch([message])
+
+            loader.close()
+            loader = None
+            self.assertEqual(count * 2, self.streamCount(key))
+        finally:
+            if loader != None:
+                loader.close()
+            self.deleteStream(key)
+
+    def test_SendInvalidMessages(self):
+        key = self.streamKeys[0]
+        stream = self.createStreamQQL(key)
+        loader = stream.createLoader(tbapi.LoadingOptions())
+        try:
+            # invalid messages are rejected before loader starts them, so the next messages are sent intact
+            message = tbapi.InstrumentMessage()
+            message.typeName = 'deltix.timebase.api.messages.BarMessage'
+            message.symbol = 'AAPL'
+            for asyncSize in [0, 10]:
+                loader.setAsync(asyncSize)
+                for i in range(3):
+                    message.timestamp = (asyncSize + i) * 1000000
+                    message.close = 'invalid' if i == 1 else float(i)
+                    if i == 1:
+                        with self.assertRaises(Exception):
+                            loader.send(message)
+                    else:
+                        loader.send(message)
+                loader.flush()
+
+            loader.setAsync(0)
+            with self.assertRaises(Exception):
+                loader.sendColumns('deltix.timebase.api.messages.BarMessage', 'AAPL', array.array('q', [100000000]), {
+                    'close': ['invalid']
+                })
+            loader.close()
+            loader = None
+
+            cursor = stream.createCursor(tbapi.SelectionOptions())
+            try:
+                cursor.reset(0)
+                closes = []
+                while cursor.next():
+                    closes.append(cursor.getMessage().close)
+                self.assertEqual([0.0, 2.0, 0.0, 2.0], closes)
+            finally:
+                cursor.close()
+        finally:
+            if loader != None:
+                loader.close()
+            self.deleteStream(key)
+
+    def test_SendColumns(self):
+        key = self.streamKeys[0]
+        stream = self.createStreamQQL(key)
+        loader = stream.createLoader(tbapi.LoadingOptions())
+        try:
+            count = 1000
+            timestamps = array.array('q', [i * 1000000000 for i in range(count)])
+            close = array.array('d', [float(i) for i in range(count)])
+            close[10] = float('nan')
+            symbols = ['AAPL' if i % 2 == 0 else 'EPAM' for i in range(count)]
+            sent = loader.sendColumns('deltix.timebase.api.messages.BarMessage', symbols, timestamps, {
+                'currencyCode': [840] * count,
+                'close': close,
+                'volume': memoryview(close)
+            })
+            loader.close()
+            loader = None
+            self.assertEqual(count, sent)
+
+            cursor = stream.createCursor(tbapi.SelectionOptions())
+            try:
+                cursor.reset(0)
+                read = 0
+                while cursor.next():
+                    message = cursor.getMessage()
+                    self.assertEqual(read * 1000000000, message.timestamp)
+                    self.assertEqual(symbols[read], message.symbol)
+                    self.assertEqual(840, message.currencyCode)
+                    if read == 10:
+                        self.assertIsNone(message.close)
+                    else:
+                        self.assertEqual(float(read), message.close)
+                    self.assertIsNone(message.open)
+                    read += 1
+                self.assertEqual(count, read)
+            finally:
+                cursor.close()
+
+            loader = stream.createLoader(tbapi.LoadingOptions())
+            with self.assertRaises(Exception):
+                loader.sendColumns('deltix.timebase.api.messages.BarMessage', 'AAPL', timestamps, {'unknown': close})
+            with self.assertRaises(Exception):
+                loader.sendColumns('deltix.timebase.api.messages.BarMessage', 'AAPL', timestamps, {'close': close[:10]})
+        finally:
+            if loader != None:
+                loader.close()
+            self.deleteStream(key)
+
+    def test_SendColumnsParallel(self):
+        key = self.streamKeys[0]
+        stream = self.createStreamQQL(key)
+        loader = stream.createLoader(tbapi.LoadingOptions())
+        try:
+            loader.setWorkers(4, tbapi.LoadingOptions())
+            count = 10000
+            symbolNames = ['S' + str(i) for i in range(16)]
+            symbols = [symbolNames[i % len(symbolNames)] for i in range(count)]
+            timestamps = array.array('q', [i * 1000000 for i in range(count)])
+            close = array.array('d', [float(i) for i in range(count)])
+            self.assertEqual(count, loader.sendColumns('deltix.timebase.api.messages.BarMessage', symbols, timestamps, {
+                'close': close,
+                'currencyCode': [840] * count
+            }))
+            self.assertEqual(1, loader.sendColumns('deltix.timebase.api.messages.BarMessage', 'S0', array.array('q', [count * 1000000]), {
+                'close': array.array('d', [float(count)])
+            }))
+            with self.assertRaises(Exception):
+                loader.sendColumns('deltix.timebase.api.messages.BarMessage', array.array('i', [0]), array.array('q', [0]), {})
+            loader.close()
+            loader = None
+
+            cursor = stream.createCursor(tbapi.SelectionOptions())
+            try:
+                cursor.reset(0)
+                lastClose = {}
+                read = 0
+                while cursor.next():
+                    message = cursor.getMessage()
+                    self.assertEqual(message.timestamp // 1000000, int(message.close))
+                    # messages of every symbol are sent in order
+                    self.assertLess(lastClose.get(message.symbol, -1.0), message.close)
+                    lastClose[message.symbol] = message.close
+                    read += 1
+                self.assertEqual(count + 1, read)
+                self.assertEqual(set(symbolNames), set(lastClose.keys()))
+            finally:
+                cursor.close()
+        finally:
+            if loader != None:
+                loader.close()
+            self.deleteStream(key)
+
+    def test_AsyncSend(self):
+        key = self.streamKeys[0]
+        stream = self.createStreamQQL(key)
+        loader = stream.createLoader(tbapi.LoadingOptions())
+        try:
+            loader.setAsync(100)
+            count = 5000
+            # message object is reused, values are read by send
+            message = tbapi.InstrumentMessage()
+            message.typeName = 'deltix.timebase.api.messages.BarMessage'
+            message.symbol = 'AAPL'
+            for i in range(count):
+                message.timestamp = i * 1000000
+                message.close = float(i)
+                loader.send(message)
+            loader.flush()
+            self.assertEqual(0, loader.nDroppedMessages())
+            with self.assertRaises(Exception):
+                loader.sendColumns('deltix.timebase.api.messages.BarMessage', 'AAPL', array.array('q', [0]), {})
+
+            loader.setAsync(0)
+            loader.close()
+            loader = None
+
+            cursor = stream.createCursor(tbapi.SelectionOptions())
+            try:
+                cursor.reset(0)
+                read = 0
+                while cursor.next():
+                    self.assertEqual(float(read), cursor.getMessage().close)
+                    read += 1
+                self.assertEqual(count, read)
+            finally:
+                cursor.close()
+        finally:
+            if loader != None:
+                loader.close()
+            self.deleteStream(key)
+
+    def test_SendFromThreads(self):
+        key = self.streamKeys[0]
+        stream = self.createStreamQQL(key)
+        loader = stream.createLoader(tbapi.LoadingOptions())
+        try:
+            # loader sends and flushes messages without GIL, so threads share it
+            count = 2000
+            symbols = ['T' + str(i) for i in range(4)]
+            errors = []
+
+            def sendMessages(symbol):
+                try:
+                    for i in range(count):
+                        message = tbapi.InstrumentMessage()
+                        message.typeName = 'deltix.timebase.api.messages.BarMessage'
+                        message.symbol = symbol
+                        message.timestamp = i * 1000000
+                        message.close = float(i)
+                        loader.send(message)
+                        if i % 500 == 0:
+                            loader.flush()
+                except Exception as e:
+                    errors.append(e)
+
+            threads = [threading.Thread(target=sendMessages, args=(symbol,)) for symbol in symbols]
+            for thread in threads:
+                thread.start()
+            for thread in threads:
+                thread.join()
+            self.assertEqual([], errors)
+
+            loader.close()
+            loader = None
+            self.assertEqual(count * len(symbols), self.streamCount(key))
+        finally:
+            if loader != None:
+                loader.close()
+            self.deleteStream(key)
+
+    def test_SendMessageClasses(self):
+        key = self.streamKeys[0]
+        stream = self.createStreamQQL(key)
+        loader = stream.createLoader(tbapi.LoadingOptions())
+        try:
+            @dataclasses.dataclass
+            class Bar:
+                symbol: str
+                timestamp: int
+                close: float
+                typeName: str = 'deltix.timebase.api.messages.BarMessage'
+                currencyCode: int = 840
+
+            class SlotsBar:
+                __slots__ = ('symbol', 'timestamp', 'typeName', 'close')
+
+            class PropertyBar(tbapi.InstrumentMessage):
+                @property
+                def close(self):
+                    return float(self.timestamp // 1000000000)
+
+            count = 300
+            for i in range(count):
+                if i % 3 == 0:
+                    message = Bar('AAPL', i * 1000000000, float(i))
+                elif i % 3 == 1:
+                    message = SlotsBar()
+                    message.symbol = 'AAPL'
+                    message.timestamp = i * 1000000000
+                    message.typeName = 'deltix.timebase.api.messages.BarMessage'
+                    message.close = float(i)
+                else:
+                    message = PropertyBar()
+                    message.symbol = 'AAPL'
+                    message.timestamp = i * 1000000000
+                    message.typeName = 'deltix.timebase.api.messages.BarMessage'
+                loader.send(message)
+
+            # plans of modified class are rebuilt
+            Bar.open = 1.5
+            loader.send(Bar('AAPL', count * 1000000000, float(count)))
+            loader.close()
+            loader = None
+
+            cursor = stream.createCursor(tbapi.SelectionOptions())
+            try:
+                cursor.reset(0)
+                read = 0
+                while cursor.next():
+                    message = cursor.getMessage()
+                    self.assertEqual(read * 1000000000, message.timestamp)
+                    self.assertEqual(float(read), message.close)
+                    if read % 3 == 0:
+                        self.assertEqual(840, message.currencyCode)
+                    else:
+                        self.assertIsNone(message.currencyCode)
+                    if read == count:
+                        self.assertEqual(1.5, message.open)
+                    else:
+                        self.assertIsNone(message.open)
+                    read += 1
+                self.assertEqual(count + 1, read)
+            finally:
+                cursor.close()
+        finally:
+            if loader != None:
+                loader.close()
+            self.deleteStream(key)
+
+    def test_SendSymbolObjects(self):
+        key = self.streamKeys[1]
+        stream = self.createStreamQQL(key)
+        loader = stream.createLoader(tbapi.LoadingOptions())
+        try:
+            class Symbol(str):
+                pass
+
+            # equal symbols in distinct, reused and subclassed string objects have the same id
+            symbols = ['MSFT', ''.join(['MS', 'FT']), Symbol('MSFT'), 'ORCL', ''.join(['OR', 'CL'])]
+            typeNames = ['deltix.timebase.api.messages.TradeMessage', ''.join(['deltix.timebase.api.messages.', 'TradeMessage'])]
+            count = 1000
+            for i in range(count):
+                message = tbapi.InstrumentMessage()
+                message.typeName = typeNames[i % len(typeNames)]
+                message.symbol = symbols[i % len(symbols)]
+                message.timestamp = i
+                message.price = float(i)
+                message.size = 1.0
+                loader.send(message)
+
+            message = tbapi.InstrumentMessage()
+            message.typeName = typeNames[0]
+            message.symbol = ''
+            with self.assertRaises(Exception):
+                loader.send(message)
+            message.symbol = b'MSFT'
+            with self.assertRaises(Exception):
+                loader.send(message)
+            loader.close()
+            loader = None
+
+            cursor = stream.createCursor(tbapi.SelectionOptions())
+            try:
+                cursor.reset(0)
+                counts = {}
+                while cursor.next():
+                    symbol = cursor.getMessage().symbol
+                    counts[symbol] = counts.get(symbol, 0) + 1
+                self.assertEqual({'MSFT': 600, 'ORCL': 400}, counts)
+            finally:
+                cursor.close()
+        finally:
+            if loader != None:
+                loader.close()
+            self.deleteStream(key)
+
     def test_InsertWriteMode(self):
         key = self.streamKeys[1]
         try:
@@ -27,6 +27,24 @@ class TestMultithreaded(servertest.TestWithStreams):
 
         self.assertEqual(results[0], 3000)
 
+    def test_NextWithLoader(self):
+        self.db.getStream("bars1min").truncate(-1)
+
+        # blocking live cursor should not stop loader thread
+        results = [None] * 1
+        reader = threading.Thread(target = self.readStreamBlocking, args = (results, 0, self.streamKeys[0], 3000, ))
+        writer = threading.Thread(target = self.loadBarsThread, args = ("bars1min", 3000, ))
+
+        reader.start()
+        time.sleep(1)
+        writer.start()
+
+        writer.join()
+        reader.join(60)
+
+        self.assertFalse(reader.is_alive())
+        self.assertEqual(results[0], 3000)
+
     def test_NextIfAvailable3Cursors(self):
         results = [None] * 3
         reader1 = threading.Thread(target = self.readStream, args = (results, 0, self.streamKeys[0], 1000000000, ))
@@ -146,5 +164,23 @@ class TestMultithreaded(servertest.TestWithStreams):
         print("Total read from " + key + ": " + str(messages))
         results[num] = messages
 
+    def readStreamBlocking(self, results, num, key, readUntil):
+        stream = self.db.getStream(key)
+        options = tbapi.SelectionOptions()
+        options.live = True
+
+        cursor = stream.createCursor(options)
+        try:
+            cursor.reset(0)
+
+            messages = 0
+            while messages < readUntil and cursor.next():
+                cursor.getMessage()
+                messages += 1
+            print("Total read from " + key + ": " + str(messages))
+            results[num] = messages
+        finally:
+            cursor.close()
+
 if __name__ == '__main__':
     unittest.main()
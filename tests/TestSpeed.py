@@ -1,13 +1,14 @@
 import unittest
 import servertest
 import generators
+import testutils
 import time
 import tbapi
 
 class TestSpeed(servertest.TBServerTest):
 
     streamKeys = [
-        'bars1min', 'tradeBBO', 'l2'
+        'bars1min', 'tradeBBO', 'l2', 'universal'
     ]
 
     def setUp(self):
@@ -189,5 +190,55 @@ class TestSpeed(servertest.TBServerTest):
         finally:
             cursor.close()
 
+    # per-field decode cost of every path of MessageCodec on the tests/testdata schemas,
+    # run it on builds of two revisions to compare them (field counts include header)
+    def test_DecodeFieldSpeed(self):
+        loaders = [testutils.loadBars, testutils.loadTradeBBO, testutils.loadL2, testutils.loadUniversal]
+        for (key, load) in zip(self.streamKeys, loaders):
+            stream = self.db.getStream(key)
+            load(stream, 100000)
+
+            with stream.tryCursor(tbapi.SelectionOptions()) as cursor:
+                fieldsCount = {}
+                read = 0
+                decoded = 0
+                startMeasure = time.time()
+                while cursor.next():
+                    message = cursor.getMessage()
+                    if message.typeName not in fieldsCount:
+                        fieldsCount[message.typeName] = len(vars(message))
+                    decoded = decoded + fieldsCount[message.typeName]
+                    read = read + 1
+                timeMeasure = (time.time() - startMeasure)
+                print('Stream: ' + key + ', messages: ' + str(read) + ', fields: ' + str(decoded))
+                print('Message decode: ' + str(timeMeasure * 1e9 / decoded) + ' ns/field')
+
+            with stream.tryCursor(tbapi.SelectionOptions()) as cursor:
+                cursor.setTypedMessages(True)
+                startMeasure = time.time()
+                while cursor.next():
+                    cursor.getMessage()
+                timeMeasure = (time.time() - startMeasure)
+                print('Typed message decode: ' + str(timeMeasure * 1e9 / decoded) + ' ns/field')
+
+            # fields are skipped, only header is decoded
+            with stream.tryCursor(tbapi.SelectionOptions()) as cursor:
+                cursor.setFields([])
+                startMeasure = time.time()
+                while cursor.next():
+                    cursor.getMessage()
+                timeMeasure = (time.time() - startMeasure)
+                print('Skip: ' + str(timeMeasure * 1e9 / decoded) + ' ns/field')
+
+            with stream.tryCursor(tbapi.SelectionOptions()) as cursor:
+                decoded = 0
+                startMeasure = time.time()
+                batch = cursor.nextBatch(10000)
+                while len(batch) > 0:
+                    decoded = decoded + len(batch) * len(batch.keys())
+                    batch = cursor.nextBatch(10000)
+                timeMeasure = (time.time() - startMeasure)
+                print('Batch decode: ' + str(timeMeasure * 1e9 / decoded) + ' ns/field')
+
 if __name__ == '__main__':
     unittest.main()